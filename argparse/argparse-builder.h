@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "argparse/internal/argparse-encoding.h"
 #include "argparse/internal/argparse-internal.h"
 
 namespace argparse {
@@ -67,17 +68,22 @@ class Dest : private SimpleBuilder<internal::DestInfo> {
   friend class BuilderAccessor;
 };
 
-class NameOrNames final : private SimpleBuilder<internal::NamesInfo> {
+// NamesInfo only keeps views of the names, so it is created by the
+// ArgumentBuilder, which owns the copies of the non-literal names.
+class NameOrNames final {
  public:
-  NameOrNames(absl::string_view name) {
-    this->SetObject(internal::NamesInfo::CreateSingleName(name));
-  }
-  NameOrNames(std::initializer_list<absl::string_view> names) {
-    this->SetObject(internal::NamesInfo::CreateOptionalNames(names));
+  NameOrNames(SpecString name) : names_{name}, is_single_(true) {}
+  NameOrNames(std::initializer_list<SpecString> names)
+      : names_(names), is_single_(false) {}
+
+  void ApplyTo(ArgumentBuilder* builder) const {
+    if (is_single_) return builder->SetSingleName(names_.front());
+    builder->SetOptionalNames(names_);
   }
 
  private:
-  friend class BuilderAccessor;
+  absl::InlinedVector<SpecString, 1> names_;
+  bool is_single_;
 };
 
 class FlagOrNumber final : private SimpleBuilder<internal::NumArgsInfo> {
@@ -93,17 +99,19 @@ class FlagOrNumber final : private SimpleBuilder<internal::NumArgsInfo> {
   friend class BuilderAccessor;
 };
 
-class AnyValue : private SimpleBuilder<internal::Any> {
+// Any is a value type, so it is held directly instead of through a pointer.
+class AnyValue {
  public:
   template <typename T,
             absl::enable_if_t<!std::is_convertible<T, AnyValue>{}>* = nullptr>
-  AnyValue(T&& val) {
-    auto obj = internal::MakeAny<absl::decay_t<T>>(std::forward<T>(val));
-    this->SetObject(std::move(obj));
-  }
+  AnyValue(T&& val)
+      : value_(internal::MakeAny<absl::decay_t<T>>(std::forward<T>(val))) {}
 
  private:
+  internal::Any Build() { return std::move(value_); }
+
   friend class BuilderAccessor;
+  internal::Any value_;
 };
 
 #define ARGPARSE_BUILDER_INTERNAL_COMMON()                         \
@@ -119,13 +127,13 @@ class AnyValue : private SimpleBuilder<internal::Any> {
 template <typename Derived>
 class NonTypeMethodsBase {
  public:
-  Derived& Help(absl::string_view val) {
+  Derived& Help(SpecString val) {
     return Invoke(&ArgumentBuilder::SetHelp, val);
   }
   Derived& Required(bool val) {
     return Invoke(&ArgumentBuilder::SetRequired, val);
   }
-  Derived& MetaVar(absl::string_view val) {
+  Derived& MetaVar(SpecString val) {
     return Invoke(&ArgumentBuilder::SetMetaVar, val);
   }
   Derived& NumArgs(FlagOrNumber num_args) {
@@ -148,11 +156,24 @@ template <typename Derived, typename T>
 class SelectValueTypeMethods<Derived, T,
                              absl::enable_if_t<std::is_enum<T>::value>> {
  public:
-  // TODO:
-  Derived& EnumType(internal::EnumValues<T> values) {
+  // Take only the names in `values`. They are copied.
+  Derived& EnumType(internal::EnumValues<T> values,
+                    EnumCase match = EnumCase::kSensitive) {
+    return Invoke(&ArgumentBuilder::SetTypeInfo,
+                  TypeInfo::CreateEnumType(values, match));
+  }
+  // Like EnumType(), but `table` is looked up in place, so it must outlive
+  // the parser, e.g., a static constexpr array. A table sorted by name needs
+  // no allocation.
+  template <std::size_t N>
+  Derived& EnumTable(const internal::EnumChoice<T> (&table)[N],
+                     EnumCase match = EnumCase::kSensitive) {
     return Invoke(&ArgumentBuilder::SetTypeInfo,
-                  TypeInfo::CreateEnumType(values));
+                  TypeInfo::CreateEnumTable<T>(table, match));
   }
+  template <std::size_t N>
+  void EnumTable(const internal::EnumChoice<T>(&&table)[N],
+                 EnumCase match = EnumCase::kSensitive) = delete;
 
  private:
   ARGPARSE_BUILDER_INTERNAL_COMMON();
@@ -170,13 +191,32 @@ class SelectValueTypeMethods<
   ARGPARSE_BUILDER_INTERNAL_COMMON();
 };
 
+template <typename Derived, typename T>
+class SelectValueTypeMethods<
+    Derived, T, absl::enable_if_t<internal::IsByteBuffer<T>::value>> {
+ public:
+  // Decode the value from hex, like "deadbeef". A std::array takes exactly N
+  // bytes.
+  Derived& Hex() {
+    return Invoke(&ArgumentBuilder::SetTypeInfo,
+                  TypeInfo::CreateCallbackType<T>(
+                      &internal::encoding_internal::DecodeHexTo<T>));
+  }
+  // Likewise, from base64 with padding, like "3q2+7w==".
+  Derived& Base64() {
+    return Invoke(&ArgumentBuilder::SetTypeInfo,
+                  TypeInfo::CreateCallbackType<T>(
+                      &internal::encoding_internal::DecodeBase64To<T>));
+  }
+
+ private:
+  ARGPARSE_BUILDER_INTERNAL_COMMON();
+};
+
 // Methods added here are common to all value-types.
 template <typename Derived, typename T>
 class ValueTypeMethodsBase : public SelectValueTypeMethods<Derived, T> {
  public:
-  Derived& Action(absl::string_view str) {
-    return Invoke(&ArgumentBuilder::SetActionString, str);
-  }
   Derived& Action(ActionCallback<T>&& func) {
     return Invoke(&ArgumentBuilder::SetActionInfo,
                   ActionInfo::CreateCallbackAction(std::move(func)));
@@ -208,9 +248,66 @@ class TypeMethodsBase : public ValueTypeMethodsBase<Derived, U> {};
 template <typename Derived, typename T>
 class TypeMethodsBase<Derived, T, void> : public FakeValueTypeMethodsBase {};
 
+// Methods added to a dest according to T, like SelectValueTypeMethods.
+template <typename Derived, typename T, typename = void>
+class SelectDestMethods {};
+
+template <typename Derived, typename T>
+class SelectDestMethods<
+    Derived, T, absl::enable_if_t<internal::IsAppendSupported<T>::value>> {
+ public:
+  // Split a value like "a,b,c" on `delimiter` and append each piece, which is
+  // parsed by the value-type's Type(). This implies the append action, so it
+  // is a CHECK failure with a custom Action().
+  Derived& Delimiter(char delimiter) {
+    return Invoke(&ArgumentBuilder::SetDelimiter, delimiter);
+  }
+
+ private:
+  ARGPARSE_BUILDER_INTERNAL_COMMON();
+};
+
+template <typename Derived, typename T>
+class SelectDestMethods<
+    Derived, T, absl::enable_if_t<internal::IsInsertSupported<T>::value>> {
+ public:
+  // Split a value like "a=1,b=2" on `delimiter` and insert each pair.
+  Derived& Delimiter(char delimiter) {
+    return Invoke(&ArgumentBuilder::SetDelimiter, delimiter);
+  }
+  // What to do with a key given again, the default is to overwrite.
+  Derived& DuplicateKeys(DuplicateKey policy) {
+    return Invoke(&ArgumentBuilder::SetDuplicateKey, policy);
+  }
+
+ private:
+  ARGPARSE_BUILDER_INTERNAL_COMMON();
+};
+
+template <typename Derived, typename T>
+class SelectDestMethods<
+    Derived, T,
+    absl::enable_if_t<internal::IsTupleType<T>::value ||
+                      internal::IsFixedCapacity<T>::value>> {
+ public:
+  // An option gets all the elements in one value, like "1,2.5,label", split
+  // on `delimiter`, which is ',' by default. A positional takes one value per
+  // element. The size of the dest is the nargs. An explicit NumArgs() that
+  // does not match it is a CHECK failure when the argument is built, even for
+  // a std::array, not a compile error. A Span is checked again as it is
+  // parsed, as it may be bound to another buffer in between.
+  Derived& Delimiter(char delimiter) {
+    return Invoke(&ArgumentBuilder::SetDelimiter, delimiter);
+  }
+
+ private:
+  ARGPARSE_BUILDER_INTERNAL_COMMON();
+};
+
 // DestMethodsBase add the methods bound to the type of dest.
 template <typename Derived, typename T>
-class DestMethodsBase : public ValueTypeMethodsBase<Derived, T> {
+class DestMethodsBase : public ValueTypeMethodsBase<Derived, T>,
+                        public SelectDestMethods<Derived, T> {
  public:
   Derived& DefaultValue(T&& value) {
     return Invoke(&ArgumentBuilder::SetDefaultValue,
@@ -238,6 +335,14 @@ class TypedMethodsBase : public DestMethodsBase<Derived, T>,
 
   using DestBase::ConstValue;
   using TypeBase::ConstValue;
+
+  // Not bound to T, so it is defined once here instead of in both bases.
+  Derived& Action(absl::string_view str) {
+    return Invoke(&ArgumentBuilder::SetActionString, str);
+  }
+
+ private:
+  ARGPARSE_BUILDER_INTERNAL_COMMON();
 };
 
 template <typename T>
@@ -247,18 +352,18 @@ class ArgumentBuilderProxy
  public:
   ArgumentBuilderProxy(NameOrNames names, T* ptr) {
     GetBuilder()->SetDest(DestInfo::CreateFromPtr(ptr));
-    GetBuilder()->SetNames(BuilderAccessor::Build(&names));
+    names.ApplyTo(GetBuilder());
   }
 
  private:
   // For BuilderAccessor::Build()
   std::unique_ptr<internal::Argument> Build() { return GetBuilder()->Build(); }
   // For BuilderAccessor::GetBuilder()
-  internal::ArgumentBuilder* GetBuilder() { return builder_.get(); }
+  internal::ArgumentBuilder* GetBuilder() { return &builder_; }
 
   friend class BuilderAccessor;
-  std::unique_ptr<internal::ArgumentBuilder> builder_ =
-      internal::ArgumentBuilder::Create();
+  // Held by value to save an allocation per argument.
+  internal::ArgumentBuilder builder_;
 };
 
 // This is a helper that provides add_argument().
@@ -413,18 +518,82 @@ class ArgumentParser final
                           val);
     return *this;
   }
+  // A hint of how many arguments, argument groups and names are going to be
+  // added, so that registering a large spec doesn't rehash or reallocate.
+  // `names` defaults to `args`.
+  ArgumentParser& Reserve(std::size_t args, std::size_t groups = 0,
+                          std::size_t names = 0) {
+    controller_.Reserve(args, groups, names);
+    return *this;
+  }
+  // Release the parser in O(1) by leaking its memory when it is destroyed.
+  // Use it for a parser that lives until the end of main().
+  ArgumentParser& FastTeardown(bool enable = true) {
+    controller_.SetFastTeardown(enable);
+    return *this;
+  }
+  // Report the bytes and allocations used by the spec, broken down by the
+  // kind of object, per group and per subcommand.
+  MemoryReport GetMemoryReport() const { return controller_.GetMemoryReport(); }
+  // `argv` is taken as persistent: absl::string_view dests (and the like, see
+  // IsViewType) point into it, so it must outlive them. The argv of main()
+  // does. The strings of an ArgVector are taken as transient, and parsing
+  // them into such dests fails.
   void ParseArgs(int argc, const char** argv) {
-    ParseArgsImpl(internal::ArgArray(argc, argv), nullptr);
+    ParseArgsImpl(internal::ArgArray(argc, argv), nullptr).IgnoreError();
   }
   void ParseArgs(internal::ArgVector args) {
-    ParseArgsImpl(internal::ArgArray(args), nullptr);
+    ParseArgsImpl(internal::ArgArray(args), nullptr).IgnoreError();
   }
   bool ParseKnownArgs(int argc, const char** argv,
                       std::vector<std::string>* out) {
-    return ParseArgsImpl(internal::ArgArray(argc, argv), out);
+    return ParseArgsImpl(internal::ArgArray(argc, argv), out).ok();
   }
   bool ParseKnownArgs(internal::ArgVector args, std::vector<std::string>* out) {
-    return ParseArgsImpl(internal::ArgArray(args), out);
+    return ParseArgsImpl(internal::ArgArray(args), out).ok();
+  }
+  // Put the indices into argv of the unknown tokens into `unknown`, in order.
+  // No string is copied, and a vector reused across calls keeps its capacity,
+  // so prefer this form when forwarding the rest to another parser. The
+  // backend still allocates its own buffers on each call. Unknown options are
+  // among them, but the value of one must be joined with '=', as in
+  // "--name=value", or it is taken as a positional.
+  bool ParseKnownArgs(int argc, const char** argv, std::vector<int>* unknown) {
+    unknown->clear();
+    return controller_.ParseKnownArgs(internal::ArgArray(argc, argv), unknown)
+        .ok();
+  }
+  // Like ParseKnownArgs(), but tell why the parse failed. A parse that goes
+  // beyond the budget fails with ResourceExhausted.
+  absl::Status TryParseKnownArgs(int argc, const char** argv,
+                                 std::vector<std::string>* out) {
+    return ParseArgsImpl(internal::ArgArray(argc, argv), out);
+  }
+  absl::Status TryParseKnownArgs(int argc, const char** argv,
+                                 std::vector<int>* unknown) {
+    return TryParseKnownArgs(internal::ArgArray(argc, argv), unknown);
+  }
+  // Parse a std::vector<std::string> or a span of absl::string_view as it is,
+  // without building a char** out of it, e.g.,
+  // TryParseKnownArgs(ArgArray(tokens, ArgStorage::kPersistent), &unknown).
+  absl::Status TryParseKnownArgs(internal::ArgArray args,
+                                 std::vector<int>* unknown) {
+    unknown->clear();
+    return controller_.ParseKnownArgs(args, unknown);
+  }
+  // Say how long the strings of `args` live, e.g., kPersistent for a buffer
+  // that is kept alive as long as the dests.
+  absl::Status TryParseKnownArgs(internal::ArgVector args,
+                                 internal::ArgStorage storage,
+                                 std::vector<std::string>* out) {
+    return ParseArgsImpl(internal::ArgArray(args, storage), out);
+  }
+  // Limit the bytes, appended values and tokens of each parse call. Use it
+  // when argv comes from less-trusted sources. It also sets the threads a
+  // parse may start to convert many values, which is none by default.
+  ArgumentParser& Budget(const internal::ParseBudget& budget) {
+    controller_.SetParseBudget(budget);
+    return *this;
   }
   template <typename SubCommandGroupT>
   SubCommandGroupProxy AddSubParsers(SubCommandGroupT&& group) {
@@ -432,8 +601,14 @@ class ArgumentParser final
   }
 
  private:
-  bool ParseArgsImpl(internal::ArgArray args, std::vector<std::string>* out) {
-    return controller_.ParseKnownArgs(args, out);
+  // Copy the unknown tokens out of `args`.
+  absl::Status ParseArgsImpl(internal::ArgArray args,
+                             std::vector<std::string>* out) {
+    if (!out) return controller_.ParseKnownArgs(args, nullptr);
+    std::vector<int> unknown;
+    auto status = controller_.ParseKnownArgs(args, &unknown);
+    for (int index : unknown) out->emplace_back(args[index]);
+    return status;
   }
   void AddArgumentImpl(std::unique_ptr<internal::Argument> arg) {
     return controller_.AddArgument(std::move(arg));
@@ -455,16 +630,30 @@ class ArgumentParser final
 }  // namespace internal
 
 using ArgumentParser = internal::builder_internal::ArgumentParser;
+using MemoryReport = internal::MemoryReport;
+using ParseBudget = internal::ParseBudget;
+using ArgStorage = internal::ArgStorage;
+using ArgArray = internal::ArgArray;
+using ByteSize = internal::ByteSize;
+using RangeSet = internal::RangeSet;
+using IpAddress = internal::IpAddress;
+using HostPort = internal::HostPort;
+using IpPrefix = internal::IpPrefix;
+using IpPrefixTable = internal::IpPrefixTable;
+using EnumCase = internal::EnumCase;
+template <typename T>
+using EnumChoice = internal::EnumChoice<T>;
 
+// Names, help and metavar given as string literals are not copied.
 template <typename T>
 internal::builder_internal::ArgumentBuilderProxy<T> Argument(
-    absl::string_view name, T* dest) {
+    internal::SpecString name, T* dest) {
   return {name, dest};
 }
 
 template <typename T>
 internal::builder_internal::ArgumentBuilderProxy<T> Argument(
-    std::initializer_list<absl::string_view> names, T* dest) {
+    std::initializer_list<internal::SpecString> names, T* dest) {
   return {names, dest};
 }
 
@@ -0,0 +1,66 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "argparse/argparse-builder.h"
+#include "benchmark/benchmark.h"
+
+// Registration should be linear in the number of arguments. Run with
+// --benchmark_filter=AddArgument to see the fitted complexity.
+namespace argparse {
+namespace {
+
+// Like the flags generated from a schema, the names are not literals.
+std::vector<std::string> MakeNames(int count) {
+  std::vector<std::string> names;
+  names.reserve(count);
+  for (int i = 0; i < count; ++i) names.push_back("--flag-" + std::to_string(i));
+  return names;
+}
+
+void AddArguments(benchmark::State& state, bool reserve) {
+  const int count = static_cast<int>(state.range(0));
+  const auto names = MakeNames(count);
+  std::vector<int> dests(count);
+
+  for (auto _ : state) {
+    auto parser = absl::make_unique<ArgumentParser>();
+    if (reserve) parser->Reserve(count);
+    for (int i = 0; i < count; ++i) {
+      parser->AddArgument(
+          Argument(names[i], &dests[i]).Help("A generated flag."));
+    }
+    // Teardown is not what we measure here.
+    state.PauseTiming();
+    parser.reset();
+    state.ResumeTiming();
+  }
+  state.SetComplexityN(count);
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+void BM_AddArgument(benchmark::State& state) { AddArguments(state, false); }
+void BM_AddArgumentReserved(benchmark::State& state) {
+  AddArguments(state, true);
+}
+
+BENCHMARK(BM_AddArgument)
+    ->RangeMultiplier(8)
+    ->Range(1 << 8, 1 << 17)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
+BENCHMARK(BM_AddArgumentReserved)
+    ->RangeMultiplier(8)
+    ->Range(1 << 8, 1 << 17)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
+
+}  // namespace
+}  // namespace argparse
+
+BENCHMARK_MAIN();
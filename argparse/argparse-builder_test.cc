@@ -5,6 +5,14 @@
 
 #include "argparse/argparse-builder.h"
 
+#include <array>
+#include <cstdio>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+
+#include "absl/container/fixed_array.h"
+#include "absl/strings/match.h"
 #include "argparse/internal/argparse-test-helper.h"
 #include "gtest/gtest.h"
 
@@ -13,8 +21,638 @@ namespace internal {
 namespace builder_internal {
 namespace testing_internal {
 
+enum class Level { kDebug, kInfo, kWarning };
+
+// Sorted by name, so it is looked up in place.
+constexpr EnumChoice<Level> kLevels[] = {
+    {"debug", Level::kDebug},
+    {"info", Level::kInfo},
+    {"warning", Level::kWarning},
+};
+
+// Counts the live objects, parsed by operator>>.
+struct Counted {
+  static int live;
+  int value = 0;
+
+  Counted() { ++live; }
+  Counted(const Counted& that) : value(that.value) { ++live; }
+  Counted& operator=(const Counted&) = default;
+  ~Counted() { --live; }
+};
+
+int Counted::live = 0;
+
+std::istream& operator>>(std::istream& is, Counted& counted) {
+  return is >> counted.value;
+}
+
+TEST(ArgumentParser, FastTeardownSkipsSpecDestructors) {
+  Counted dest;
+  {
+    ArgumentParser parser;
+    parser.AddArgument(
+        argparse::Argument("--dest", &dest).DefaultValue(Counted()));
+    EXPECT_EQ(Counted::live, 2);
+  }
+  // The default value held by the argument is destroyed.
+  EXPECT_EQ(Counted::live, 1);
+  {
+    ArgumentParser parser;
+    parser.FastTeardown();
+    parser.AddArgument(
+        argparse::Argument("--dest", &dest).DefaultValue(Counted()));
+  }
+  // Now it is leaked.
+  EXPECT_EQ(Counted::live, 2);
+}
+
+// gflags has no file flags.
+#ifdef ARGPARSE_USE_ARGP
+TEST(ArgumentParser, FastTeardownReleasesDests) {
+  auto path = ::testing::TempDir() + "fast_teardown.txt";
+  {
+    ScopedFile out;
+    {
+      ArgumentParser parser;
+      parser.FastTeardown();
+      parser.AddArgument(argparse::Argument("--out", &out).FileType("w"));
+      std::vector<std::string> rest;
+      ASSERT_TRUE(parser
+                      .TryParseKnownArgs({"prog", "--out", path.c_str()},
+                                         ArgStorage::kTransient, &rest)
+                      .ok());
+    }
+    // The dest outlives the parser, and it is still usable.
+    ASSERT_TRUE(out);
+    fputs("buffered", out.get());
+  }
+  // The dest closed the file, which flushed it.
+  ScopedFile in(fopen(path.c_str(), "r"));
+  ASSERT_TRUE(in);
+  char buffer[16] = {};
+  EXPECT_TRUE(fgets(buffer, sizeof(buffer), in.get()));
+  EXPECT_STREQ(buffer, "buffered");
+  std::remove(path.c_str());
+}
+
+#endif  // ARGPARSE_USE_ARGP
+
+TEST(ArgumentParser, ViewDestNeedsPersistentArgs) {
+  std::vector<absl::string_view> paths;
+  ArgumentParser parser;
+  parser.AddArgument(argparse::Argument("--path", &paths).Action("append"));
+
+  std::vector<std::string> rest;
+  auto status = parser.TryParseKnownArgs({"prog", "--path", "a"},
+                                         ArgStorage::kTransient, &rest);
+  EXPECT_TRUE(absl::IsFailedPrecondition(status));
+  EXPECT_TRUE(paths.empty());
+}
+
+// gflags exits on an unknown option, and only argp takes positionals.
+#ifdef ARGPARSE_USE_ARGP
+TEST(ArgumentParser, UnknownArgsAsIndices) {
+  int num = 0;
+  ArgumentParser parser;
+  parser.AddArgument(argparse::Argument("--num", &num));
+
+  const char* argv[] = {"prog", "--num", "1", "extra", "more"};
+  std::vector<int> unknown;
+  EXPECT_TRUE(parser.ParseKnownArgs(5, argv, &unknown));
+  EXPECT_EQ(num, 1);
+  EXPECT_EQ(unknown, (std::vector<int>{3, 4}));
+  // argv is not permuted.
+  EXPECT_STREQ(argv[3], "extra");
+
+  std::vector<std::string> rest;
+  EXPECT_TRUE(parser.ParseKnownArgs(5, argv, &rest));
+  EXPECT_EQ(rest, (std::vector<std::string>{"extra", "more"}));
+}
+
+TEST(ArgumentParser, UnknownArgsAroundOptions) {
+  int num = 0;
+  ArgumentParser parser;
+  parser.AddArgument(argparse::Argument("--num", &num));
+
+  // Extra positionals before the options and after "--".
+  const char* argv[] = {"prog", "a", "--num", "1", "--", "b", "--num=2"};
+  std::vector<int> unknown;
+  EXPECT_TRUE(parser.ParseKnownArgs(7, argv, &unknown));
+  EXPECT_EQ(num, 1);
+  EXPECT_EQ(unknown, (std::vector<int>{1, 5, 6}));
+}
+
+TEST(ArgumentParser, UnknownOptionsArePassedThrough) {
+  int num = 0;
+  ArgumentParser parser;
+  parser.AddArgument(argparse::Argument("--num", &num));
+
+  // The value of a known option is never taken as an option. That of an
+  // unknown one must be joined with '=', or it is an extra positional.
+  const char* argv[] = {"prog", "--foo=x", "--num", "-1", "-v", "--bar", "y"};
+  std::vector<int> unknown;
+  EXPECT_TRUE(parser.ParseKnownArgs(7, argv, &unknown));
+  EXPECT_EQ(num, -1);
+  EXPECT_EQ(unknown, (std::vector<int>{1, 4, 5, 6}));
+
+  // A unique prefix is taken like getopt_long() does.
+  const char* prefix[] = {"prog", "--nu=3"};
+  EXPECT_TRUE(parser.ParseKnownArgs(2, prefix, &unknown));
+  EXPECT_EQ(num, 3);
+  EXPECT_TRUE(unknown.empty());
+}
+
+#endif  // ARGPARSE_USE_ARGP
+
+// gflags has no append action to split into.
+#ifdef ARGPARSE_USE_ARGP
+TEST(ArgumentParser, DelimiterSplitsIntoAppendDest) {
+  std::vector<int> nums;
+  std::vector<std::string> hosts;
+  ArgumentParser parser;
+  parser.AddArgument(argparse::Argument("--nums", &nums).Delimiter(','));
+  parser.AddArgument(argparse::Argument("--hosts", &hosts).Delimiter(':'));
+
+  const char* argv[] = {"prog", "--nums=1,2,3", "--hosts", "a::b",
+                        "--nums", "4"};
+  std::vector<int> unknown;
+  EXPECT_TRUE(parser.ParseKnownArgs(6, argv, &unknown));
+  EXPECT_EQ(nums, (std::vector<int>{1, 2, 3, 4}));
+  // Empty pieces are kept.
+  EXPECT_EQ(hosts, (std::vector<std::string>{"a", "", "b"}));
+}
+
+TEST(ArgumentParser, DelimiterUsesValueTypeCallback) {
+  std::vector<int> nums;
+  ArgumentParser parser;
+  parser.AddArgument(
+      argparse::Argument("--nums", &nums).Delimiter(',').Type(
+          [](absl::string_view in, int* out) {
+            *out = static_cast<int>(in.size());
+            return true;
+          }));
+
+  const char* argv[] = {"prog", "--nums", "a,bb,ccc"};
+  std::vector<int> unknown;
+  EXPECT_TRUE(parser.ParseKnownArgs(3, argv, &unknown));
+  EXPECT_EQ(nums, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(ArgumentParser, DelimiterReportsBadPiece) {
+  std::vector<int> nums;
+  ArgumentParser parser;
+  parser.AddArgument(argparse::Argument("--nums", &nums).Delimiter(','));
+
+  std::vector<std::string> rest;
+  auto status = parser.TryParseKnownArgs({"prog", "--nums", "1,x,3"},
+                                         ArgStorage::kTransient, &rest);
+  EXPECT_TRUE(absl::IsInvalidArgument(status));
+  EXPECT_TRUE(
+      absl::StrContains(status.message(), "invalid int value at index 1"))
+      << status;
+}
+
+TEST(ArgumentParser, DelimiterChargesEachPiece) {
+  std::vector<int> nums;
+  ArgumentParser parser;
+  ParseBudget budget;
+  budget.max_values = 3;
+  parser.Budget(budget);
+  parser.AddArgument(argparse::Argument("--nums", &nums).Delimiter(','));
+
+  std::vector<std::string> rest;
+  auto status = parser.TryParseKnownArgs({"prog", "--nums", "1,2,3,4"},
+                                         ArgStorage::kTransient, &rest);
+  EXPECT_TRUE(absl::IsResourceExhausted(status));
+  EXPECT_TRUE(nums.empty());
+}
+
+#endif  // ARGPARSE_USE_ARGP
+
+// gflags takes no positionals.
+#ifdef ARGPARSE_USE_ARGP
+TEST(ArgumentParser, PositionalTakesManyValues) {
+  std::string mode;
+  std::vector<std::int64_t> ids;
+  int level = 0;
+  ArgumentParser parser;
+  parser.AddArgument(argparse::Argument("mode", &mode));
+  parser.AddArgument(argparse::Argument("ids", &ids).NumArgs('+'));
+  parser.AddArgument(argparse::Argument("--level", &level));
+
+  const char* argv[] = {"prog", "scan", "1", "0x10", "--level", "2", "3"};
+  std::vector<int> unknown;
+  EXPECT_TRUE(parser.ParseKnownArgs(7, argv, &unknown));
+  EXPECT_EQ(mode, "scan");
+  EXPECT_EQ(ids, (std::vector<std::int64_t>{1, 16, 3}));
+  EXPECT_EQ(level, 2);
+  EXPECT_TRUE(unknown.empty());
+}
+
+TEST(ArgumentParser, PositionalTakesManyNamesBadValue) {
+  std::vector<int> ids;
+  ParseBudget budget;
+  budget.max_threads = 4;
+  ArgumentParser parser;
+  parser.Budget(budget);
+  parser.AddArgument(argparse::Argument("ids", &ids).NumArgs('*'));
+
+  std::vector<std::string> args{"prog"};
+  for (int i = 0; i < 100000; ++i) args.push_back(std::to_string(i));
+  args[70001] = "7e";
+  std::vector<int> unknown;
+  auto status = parser.TryParseKnownArgs(
+      ArgArray(args, ArgStorage::kPersistent), &unknown);
+  EXPECT_TRUE(absl::IsInvalidArgument(status));
+  EXPECT_TRUE(absl::StrContains(status.message(), "invalid int value: '7e'"))
+      << status;
+  EXPECT_EQ(ids.size(), 70000);
+
+  ids.clear();
+  std::vector<std::string> rest;
+  EXPECT_TRUE(parser.TryParseKnownArgs({"prog"}, ArgStorage::kTransient, &rest)
+                  .ok());
+  EXPECT_TRUE(ids.empty());
+}
+
+TEST(ArgumentParser, PositionalNeedsOneOrMore) {
+  std::vector<int> ids;
+  ArgumentParser parser;
+  parser.AddArgument(argparse::Argument("ids", &ids).NumArgs('+'));
+
+  std::vector<std::string> rest;
+  auto status =
+      parser.TryParseKnownArgs({"prog"}, ArgStorage::kTransient, &rest);
+  EXPECT_TRUE(absl::IsInvalidArgument(status));
+  EXPECT_TRUE(absl::StrContains(status.message(), "one or more")) << status;
+}
+
+TEST(ArgumentParser, PositionalsAfterManyTakeTheLastValues) {
+  std::string mode;
+  std::vector<std::string> files;
+  std::pair<int, int> size;
+  std::string output;
+  ArgumentParser parser;
+  parser.AddArgument(argparse::Argument("mode", &mode));
+  parser.AddArgument(argparse::Argument("files", &files).NumArgs('*'));
+  parser.AddArgument(argparse::Argument("size", &size));
+  parser.AddArgument(argparse::Argument("output", &output));
+
+  std::vector<std::string> rest;
+  EXPECT_TRUE(parser
+                  .TryParseKnownArgs({"prog", "cat", "a", "b", "3", "4", "out"},
+                                     ArgStorage::kTransient, &rest)
+                  .ok());
+  EXPECT_EQ(mode, "cat");
+  EXPECT_EQ(files, (std::vector<std::string>{"a", "b"}));
+  EXPECT_EQ(size, std::make_pair(3, 4));
+  EXPECT_EQ(output, "out");
 
+  files.clear();
+  EXPECT_TRUE(parser
+                  .TryParseKnownArgs({"prog", "cat", "5", "6", "out2"},
+                                     ArgStorage::kTransient, &rest)
+                  .ok());
+  EXPECT_TRUE(files.empty());
+  EXPECT_EQ(output, "out2");
+
+  auto status = parser.TryParseKnownArgs({"prog", "cat", "5", "6"},
+                                         ArgStorage::kTransient, &rest);
+  EXPECT_TRUE(absl::StrContains(status.message(),
+                                "arguments are required: size, output"))
+      << status;
+}
+
+TEST(ArgumentParser, MissingPositionalIsAnError) {
+  std::string mode;
+  std::string input;
+  std::string extra;
+  ArgumentParser parser;
+  parser.AddArgument(argparse::Argument("mode", &mode));
+  parser.AddArgument(argparse::Argument("input", &input));
+  parser.AddArgument(argparse::Argument("extra", &extra).NumArgs('?'));
+
+  std::vector<std::string> rest;
+  auto status =
+      parser.TryParseKnownArgs({"prog", "cat"}, ArgStorage::kTransient, &rest);
+  EXPECT_TRUE(absl::IsInvalidArgument(status));
+  EXPECT_TRUE(
+      absl::StrContains(status.message(), "arguments are required: input"))
+      << status;
+
+  // '?' may be left out.
+  EXPECT_TRUE(parser
+                  .TryParseKnownArgs({"prog", "cat", "file"},
+                                     ArgStorage::kTransient, &rest)
+                  .ok());
+  EXPECT_EQ(input, "file");
+}
+
+#endif  // ARGPARSE_USE_ARGP
+
+// gflags has no enum flags.
+#ifdef ARGPARSE_USE_ARGP
+TEST(ArgumentParser, EnumChoices) {
+  Level level = Level::kInfo;
+  Level table_level = Level::kInfo;
+  std::vector<Level> levels;
+  ArgumentParser parser;
+  // Not sorted.
+  parser.AddArgument(argparse::Argument("--level", &level)
+                         .EnumType({{"warn", Level::kWarning},
+                                    {"debug", Level::kDebug},
+                                    {"info", Level::kInfo}}));
+  parser.AddArgument(
+      argparse::Argument("--table-level", &table_level).EnumTable(kLevels));
+  parser.AddArgument(argparse::Argument("--levels", &levels)
+                         .Action("append")
+                         .EnumTable(kLevels, EnumCase::kInsensitive));
+
+  std::vector<std::string> rest;
+  EXPECT_TRUE(parser
+                  .TryParseKnownArgs({"prog", "--level", "warn",
+                                      "--table-level", "debug", "--levels",
+                                      "INFO", "--levels", "Warning"},
+                                     ArgStorage::kTransient, &rest)
+                  .ok());
+  EXPECT_EQ(level, Level::kWarning);
+  EXPECT_EQ(table_level, Level::kDebug);
+  EXPECT_EQ(levels, (std::vector<Level>{Level::kInfo, Level::kWarning}));
+
+  // Case matters by default.
+  auto status = parser.TryParseKnownArgs({"prog", "--table-level", "Debug"},
+                                         ArgStorage::kTransient, &rest);
+  EXPECT_TRUE(absl::IsInvalidArgument(status));
+  EXPECT_TRUE(absl::StrContains(
+      status.message(),
+      "invalid choice (choose from 'debug', 'info', 'warning'): 'Debug'"))
+      << status;
+}
+
+#endif  // ARGPARSE_USE_ARGP
+
+// gflags has no binary flags.
+#ifdef ARGPARSE_USE_ARGP
+TEST(ArgumentParser, BinaryValues) {
+  std::vector<std::uint8_t> salt;
+  std::array<std::uint8_t, 4> key{};
+  std::vector<std::vector<std::uint8_t>> blobs;
+  ArgumentParser parser;
+  parser.AddArgument(argparse::Argument("--salt", &salt).Base64());
+  parser.AddArgument(argparse::Argument("--key", &key).Hex());
+  parser.AddArgument(
+      argparse::Argument("--blob", &blobs).Action("append").Hex());
+
+  std::vector<std::string> rest;
+  EXPECT_TRUE(parser
+                  .TryParseKnownArgs({"prog", "--salt", "3q2+7w==", "--key",
+                                      "00ff10ef", "--blob", "ab", "--blob",
+                                      "cdef"},
+                                     ArgStorage::kTransient, &rest)
+                  .ok());
+  EXPECT_EQ(salt, (std::vector<std::uint8_t>{0xde, 0xad, 0xbe, 0xef}));
+  EXPECT_EQ(key, (std::array<std::uint8_t, 4>{{0x00, 0xff, 0x10, 0xef}}));
+  EXPECT_EQ(blobs, (std::vector<std::vector<std::uint8_t>>{
+                       {0xab}, {0xcd, 0xef}}));
+
+  // The array takes exactly 4 bytes.
+  auto status = parser.TryParseKnownArgs({"prog", "--key", "00ff10"},
+                                         ArgStorage::kTransient, &rest);
+  EXPECT_TRUE(absl::IsInvalidArgument(status)) << status;
+}
+
+#endif  // ARGPARSE_USE_ARGP
+
+// gflags has no address flags.
+#ifdef ARGPARSE_USE_ARGP
+TEST(ArgumentParser, NetworkValues) {
+  IpPrefixTable allow;
+  HostPort upstream;
+  ArgumentParser parser;
+  parser.AddArgument(argparse::Argument("--allow", &allow).Delimiter(','));
+  parser.AddArgument(argparse::Argument("--upstream", &upstream));
+
+  std::vector<std::string> rest;
+  EXPECT_TRUE(parser
+                  .TryParseKnownArgs({"prog", "--allow=10.0.0.0/8",
+                                      "--upstream=[::1]:8080", "--allow",
+                                      "192.168.0.0/16,10.1.0.0/16"},
+                                     ArgStorage::kTransient, &rest)
+                  .ok());
+  EXPECT_EQ(allow.Format(), "10.0.0.0/8,192.168.0.0/16");
+  EXPECT_EQ(upstream.Format(), "[::1]:8080");
+
+  auto status = parser.TryParseKnownArgs({"prog", "--allow", "10.0.0.1/8"},
+                                         ArgStorage::kTransient, &rest);
+  EXPECT_TRUE(absl::StrContains(status.message(),
+                                "invalid cidr value at index 0"))
+      << status;
+}
+
+#endif  // ARGPARSE_USE_ARGP
+
+// gflags has no map flags.
+#ifdef ARGPARSE_USE_ARGP
+TEST(ArgumentParser, MapDests) {
+  std::map<std::string, std::string> labels;
+  absl::flat_hash_map<std::string, int> limits;
+  std::unordered_map<int, double> weights;
+  ArgumentParser parser;
+  parser.AddArgument(argparse::Argument("--label", &labels));
+  parser.AddArgument(argparse::Argument("--limits", &limits).Delimiter(','));
+  parser.AddArgument(argparse::Argument("--weight", &weights));
+
+  std::vector<std::string> rest;
+  EXPECT_TRUE(parser
+                  .TryParseKnownArgs({"prog", "--label", "app=web", "--label",
+                                      "tier=a=b", "--limits=cpu=4,mem=0x10",
+                                      "--weight", "1=0.5", "--label",
+                                      "app=db", "--label", "empty="},
+                                     ArgStorage::kTransient, &rest)
+                  .ok());
+  // The last value wins, and only the first '=' splits.
+  EXPECT_EQ(labels, (std::map<std::string, std::string>{
+                        {"app", "db"}, {"tier", "a=b"}, {"empty", ""}}));
+  EXPECT_EQ(limits.size(), 2);
+  EXPECT_EQ(limits["cpu"], 4);
+  EXPECT_EQ(limits["mem"], 16);
+  EXPECT_EQ(weights, (std::unordered_map<int, double>{{1, 0.5}}));
+  EXPECT_EQ((TypeHint<std::map<std::string, int>>()), "string=int");
+}
+
+TEST(ArgumentParser, MapDuplicateKeys) {
+  std::map<std::string, int> first;
+  std::map<std::string, int> unique;
+  ArgumentParser parser;
+  parser.AddArgument(argparse::Argument("--first", &first)
+                         .DuplicateKeys(DuplicateKey::kKeepFirst));
+  parser.AddArgument(argparse::Argument("--unique", &unique)
+                         .Delimiter(',')
+                         .DuplicateKeys(DuplicateKey::kError));
+
+  std::vector<std::string> rest;
+  EXPECT_TRUE(parser
+                  .TryParseKnownArgs({"prog", "--first", "a=1", "--first",
+                                      "a=2", "--unique", "a=1,b=2"},
+                                     ArgStorage::kTransient, &rest)
+                  .ok());
+  EXPECT_EQ(first, (std::map<std::string, int>{{"a", 1}}));
+
+  auto status = parser.TryParseKnownArgs({"prog", "--unique", "c=1,c=2"},
+                                         ArgStorage::kTransient, &rest);
+  EXPECT_TRUE(absl::IsInvalidArgument(status));
+  EXPECT_TRUE(
+      absl::StrContains(status.message(), "duplicate key 'c' at index 1"))
+      << status;
+
+  status = parser.TryParseKnownArgs({"prog", "--first", "b"},
+                                    ArgStorage::kTransient, &rest);
+  EXPECT_TRUE(absl::StrContains(status.message(), "expected key=value"))
+      << status;
+  status = parser.TryParseKnownArgs({"prog", "--unique", "d=x"},
+                                    ArgStorage::kTransient, &rest);
+  EXPECT_TRUE(absl::StrContains(status.message(), "invalid int value"))
+      << status;
+}
+
+// gflags has no tuple flags, and takes no positionals.
+#ifdef ARGPARSE_USE_ARGP
+#endif  // ARGPARSE_USE_ARGP
+
+TEST(ArgumentParser, TupleDests) {
+  std::tuple<int, double, std::string> point;
+  std::pair<std::string, int> origin;
+  std::pair<int, int> size;
+  std::vector<std::string> files;
+  ArgumentParser parser;
+  parser.AddArgument(argparse::Argument("point", &point));
+  parser.AddArgument(argparse::Argument("files", &files).NumArgs('*'));
+  parser.AddArgument(argparse::Argument("--origin", &origin));
+  parser.AddArgument(argparse::Argument("--size", &size).Delimiter('x'));
+
+  std::vector<std::string> rest;
+  EXPECT_TRUE(parser
+                  .TryParseKnownArgs({"prog", "--origin=home,-3", "1", "2.5",
+                                      "label", "a", "b", "--size", "640x480"},
+                                     ArgStorage::kTransient, &rest)
+                  .ok());
+  EXPECT_EQ(point, std::make_tuple(1, 2.5, std::string("label")));
+  EXPECT_EQ(files, (std::vector<std::string>{"a", "b"}));
+  EXPECT_EQ(origin, std::make_pair(std::string("home"), -3));
+  EXPECT_EQ(size, std::make_pair(640, 480));
+  EXPECT_EQ((TypeHint<std::tuple<int, double, std::string>>()),
+            "(int, double, string)");
+}
+
+TEST(ArgumentParser, TupleDestErrors) {
+  std::tuple<int, double, std::string> point;
+  std::pair<int, int> size;
+  ArgumentParser parser;
+  parser.AddArgument(argparse::Argument("point", &point));
+  parser.AddArgument(argparse::Argument("--size", &size));
+
+  std::vector<std::string> rest;
+  auto status = parser.TryParseKnownArgs({"prog", "1", "x", "label"},
+                                         ArgStorage::kTransient, &rest);
+  EXPECT_TRUE(absl::IsInvalidArgument(status));
+  EXPECT_TRUE(absl::StrContains(status.message(), "invalid double value"))
+      << status;
+
+  status = parser.TryParseKnownArgs({"prog", "1", "2"},
+                                    ArgStorage::kTransient, &rest);
+  EXPECT_TRUE(absl::StrContains(status.message(), "expected 3 values, got 2"))
+      << status;
+
+  status = parser.TryParseKnownArgs({"prog", "--size", "1,2,3"},
+                                    ArgStorage::kTransient, &rest);
+  EXPECT_TRUE(absl::StrContains(status.message(), "expected 2 values, got 3"))
+      << status;
+  status = parser.TryParseKnownArgs({"prog", "--size", "1,y"},
+                                    ArgStorage::kTransient, &rest);
+  EXPECT_TRUE(
+      absl::StrContains(status.message(), "invalid int value at index 1"))
+      << status;
+}
+
+#endif  // ARGPARSE_USE_ARGP
+
+// gflags has no array flags, and takes no positionals.
+#ifdef ARGPARSE_USE_ARGP
+TEST(ArgumentParser, ArrayDests) {
+  std::array<int, 3> rgb{};
+  absl::FixedArray<double> origin(2);
+  double buffer[4] = {};
+  absl::Span<double> weights(buffer);
+  ArgumentParser parser;
+  parser.AddArgument(argparse::Argument("rgb", &rgb));
+  parser.AddArgument(argparse::Argument("--origin", &origin));
+  parser.AddArgument(argparse::Argument("--weights", &weights).Delimiter(':'));
+
+  std::vector<std::string> rest;
+  EXPECT_TRUE(parser
+                  .TryParseKnownArgs({"prog", "--origin=0.5,-1", "255", "0x80",
+                                      "0", "--weights", "1:2:3:4"},
+                                     ArgStorage::kTransient, &rest)
+                  .ok());
+  EXPECT_EQ(rgb, (std::array<int, 3>{{255, 128, 0}}));
+  EXPECT_EQ(origin[0], 0.5);
+  EXPECT_EQ(origin[1], -1);
+  // Right into the buffer of the caller.
+  EXPECT_EQ(weights.data(), buffer);
+  EXPECT_EQ(buffer[3], 4);
+  EXPECT_EQ((TypeHint<std::array<int, 3>>()), "array[int]");
 }
+
+TEST(ArgumentParser, ArrayDestErrors) {
+  std::array<int, 3> rgb{};
+  absl::FixedArray<int> size(2);
+  ArgumentParser parser;
+  parser.AddArgument(argparse::Argument("rgb", &rgb));
+  parser.AddArgument(argparse::Argument("--size", &size));
+
+  std::vector<std::string> rest;
+  auto status = parser.TryParseKnownArgs({"prog", "1", "2"},
+                                         ArgStorage::kTransient, &rest);
+  EXPECT_TRUE(absl::StrContains(status.message(), "expected 3 values, got 2"))
+      << status;
+
+  status = parser.TryParseKnownArgs({"prog", "1", "x", "3"},
+                                    ArgStorage::kTransient, &rest);
+  EXPECT_TRUE(absl::IsInvalidArgument(status));
+  EXPECT_TRUE(absl::StrContains(status.message(), "invalid int value"))
+      << status;
+
+  status = parser.TryParseKnownArgs({"prog", "--size", "1,2,3"},
+                                    ArgStorage::kTransient, &rest);
+  EXPECT_TRUE(absl::StrContains(status.message(), "expected 2 values, got 3"))
+      << status;
+  status = parser.TryParseKnownArgs({"prog", "--size", "1,y"},
+                                    ArgStorage::kTransient, &rest);
+  EXPECT_TRUE(
+      absl::StrContains(status.message(), "invalid int value at index 1"))
+      << status;
+}
+
+TEST(ArgumentParser, SpanDestBoundToAnotherBuffer) {
+  int buffer[3] = {};
+  int smaller[2] = {};
+  absl::Span<int> span(buffer);
+  ArgumentParser parser;
+  parser.AddArgument(argparse::Argument("span", &span));
+
+  span = absl::MakeSpan(smaller);
+  std::vector<std::string> rest;
+  auto status = parser.TryParseKnownArgs({"prog", "1", "2", "3"},
+                                         ArgStorage::kTransient, &rest);
+  EXPECT_TRUE(absl::StrContains(status.message(), "expected 2 values, got 3"))
+      << status;
+  EXPECT_EQ(smaller[1], 0);
+}
+
+#endif  // ARGPARSE_USE_ARGP
+
+}  // namespace testing_internal
 }  // namespace builder_internal
 }  // namespace internal
 }  // namespace argparse
@@ -5,22 +5,33 @@
 
 #pragma once
 
+#include <array>
 #include <deque>
 #include <fstream>
 #include <list>
 #include <map>
 #include <sstream>
+#include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 #ifdef ARGPARSE_USE_FMTLIB
 #include <fmt/core.h>
 #endif
 
+#include "absl/container/fixed_array.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/types/span.h"
+#include "absl/utility/utility.h"
+#include "argparse/internal/argparse-inline-function.h"
 #include "argparse/internal/argparse-logging.h"
+#include "argparse/internal/argparse-net.h"
 #include "argparse/internal/argparse-open-traits.h"
 #include "argparse/internal/argparse-port.h"
 #include "argparse/internal/argparse-std-parse.h"
+#include "argparse/internal/argparse-range-set.h"
+#include "argparse/internal/argparse-units.h"
 
 // Defines various traits that users can specialize to meet their needs.
 namespace argparse {
@@ -47,6 +58,15 @@ enum class MetaTypes {
   kNumber,
   kBool,
   kChar,
+  kDuration,
+  kBytes,
+  kRanges,
+  kAddress,
+  kHostPort,
+  kCidr,
+  kMap,
+  kTuple,
+  kArray,
   kUnknown,
 };
 
@@ -58,16 +78,23 @@ struct MetaTypeOf : MetaTypeContant<MetaTypes::kUnknown> {};
 
 template <typename T>
 struct AppendTraits;
+template <typename T>
+struct InsertTraits;
 
 template <typename T>
 using TypeCallbackPrototype = auto(absl::string_view, T*) -> bool;
+// The value is passed as an rvalue, so the callback can take it by value,
+// by const reference or by rvalue reference.
 template <typename T>
-using ActionCallbackPrototype = auto(T) -> bool;
+using ActionCallbackPrototype = auto(T&&) -> bool;
 
+// The callbacks are stored inline and never allocate. A lambda that captures
+// more than 4 pointers' worth of state does not compile, capture a pointer to
+// the state instead.
 template <typename T>
-using TypeCallback = std::function<TypeCallbackPrototype<T>>;
+using TypeCallback = internal::InlineFunction<TypeCallbackPrototype<T>>;
 template <typename T>
-using ActionCallback = std::function<ActionCallbackPrototype<T>>;
+using ActionCallback = internal::InlineFunction<ActionCallbackPrototype<T>>;
 
 // Keep these impl here. This makes the code more coherent.
 namespace internal {
@@ -106,12 +133,19 @@ struct IsOpenSupported;
 template <typename T>
 struct IsAppendSupported;
 template <typename T>
+struct IsInsertSupported;
+template <typename T>
 struct IsNumericType;
 template <typename T>
 std::string TypeHint();
 // Helper typedef to get ValueType of AppendTraits.
 template <typename T>
 using ValueTypeOf = typename AppendTraits<T>::ValueType;
+// Likewise for InsertTraits.
+template <typename T>
+using KeyTypeOf = typename InsertTraits<T>::KeyType;
+template <typename T>
+using MappedTypeOf = typename InsertTraits<T>::MappedType;
 
 // TODO: use StrCat instead of streams.
 template <typename T>
@@ -195,6 +229,18 @@ struct MetaTypeHint {
         return "bool";
       case MetaTypes::kChar:
         return "char";
+      case MetaTypes::kDuration:
+        return "duration";
+      case MetaTypes::kBytes:
+        return "bytes";
+      case MetaTypes::kRanges:
+        return "ranges";
+      case MetaTypes::kAddress:
+        return "address";
+      case MetaTypes::kHostPort:
+        return "host:port";
+      case MetaTypes::kCidr:
+        return "cidr";
       case MetaTypes::kNumber:
         return std::string(TypeName<T>());
       default:
@@ -211,6 +257,64 @@ struct MetaTypeHint<T, MetaTypes::kList> {
   }
 };
 
+// A std::tuple or std::pair that takes one value per element.
+template <typename T>
+struct IsTupleType : std::false_type {};
+template <typename... Ts>
+struct IsTupleType<std::tuple<Ts...>>
+    : std::integral_constant<bool, sizeof...(Ts) != 0> {};
+template <typename A, typename B>
+struct IsTupleType<std::pair<A, B>> : std::true_type {};
+
+// "(int, double, string)".
+template <typename T>
+struct MetaTypeHint<T, MetaTypes::kTuple> {
+  static std::string Run() {
+    return Join(absl::make_index_sequence<std::tuple_size<T>::value>{});
+  }
+  template <std::size_t... I>
+  static std::string Join(absl::index_sequence<I...>) {
+    std::string hints[] = {
+        TypeHint<typename std::tuple_element<I, T>::type>()...};
+    std::string out = "(";
+    for (const auto& hint : hints) {
+      if (out.size() > 1) out += ", ";
+      out += hint;
+    }
+    return out + ")";
+  }
+};
+
+// A container of a size fixed before parsing, whose elements are parsed in
+// place: a std::array, an absl::FixedArray or an absl::Span over a buffer of
+// the caller.
+template <typename T>
+struct IsFixedCapacity : std::false_type {};
+template <typename T, std::size_t N>
+struct IsFixedCapacity<std::array<T, N>>
+    : std::integral_constant<bool, N != 0> {};
+template <typename T, std::size_t N, typename A>
+struct IsFixedCapacity<absl::FixedArray<T, N, A>> : std::true_type {};
+template <typename T>
+struct IsFixedCapacity<absl::Span<T>>
+    : std::integral_constant<bool, !std::is_const<T>{}> {};
+
+// "array[int]".
+template <typename T>
+struct MetaTypeHint<T, MetaTypes::kArray> {
+  static std::string Run() {
+    return "array[" + TypeHint<typename T::value_type>() + "]";
+  }
+};
+
+// "string=int".
+template <typename T>
+struct MetaTypeHint<T, MetaTypes::kMap> {
+  static std::string Run() {
+    return TypeHint<KeyTypeOf<T>>() + "=" + TypeHint<MappedTypeOf<T>>();
+  }
+};
+
 template <typename T>
 struct DefaultTypeHint<
     T, absl::enable_if_t<MetaTypes::kUnknown != MetaTypeOf<T>{}>>
@@ -250,6 +354,68 @@ template <typename T>
 struct AppendTraits<std::list<T>> : DefaultAppendTraits<std::list<T>> {};
 template <typename T>
 struct AppendTraits<std::deque<T>> : DefaultAppendTraits<std::deque<T>> {};
+// The blocks are kept sorted as they are appended.
+template <>
+struct AppendTraits<internal::IpPrefixTable> {
+  using ValueType = internal::IpPrefix;
+  static void Run(internal::IpPrefixTable* obj, ValueType item) {
+    obj->Insert(item);
+  }
+};
+
+// What happens when a key is inserted into a map again.
+enum class DuplicateKey {
+  // The last value wins, like a scalar option given twice.
+  kOverwrite,
+  kKeepFirst,
+  kError,
+};
+
+// This traits tells whether T is a map and how to insert into it. Each value,
+// like "key=value", is split on the first '=', and the halves are parsed as
+// KeyType and MappedType.
+// For user's types, specialize InsertTraits<>, and if your type is
+// standard-compatible, inherits from DefaultInsertTraits<>.
+template <typename T>
+struct InsertTraits {
+  // Run(T* obj, KeyType key, MappedType value, DuplicateKey policy) should
+  // insert under `policy`, and return false only if `key` is already in `obj`
+  // and `policy` is kError.
+  static constexpr bool Run = false;
+  using KeyType = void;
+  using MappedType = void;
+};
+
+// Default impl of InsertTraits. Use it if your type is standard-compatible.
+template <typename T>
+struct DefaultInsertTraits {
+  using KeyType = typename T::key_type;
+  using MappedType = typename T::mapped_type;
+  // A single lookup: the key is put with an empty value, which is then
+  // assigned unless the key was there already.
+  static bool Run(T* obj, KeyType key, MappedType value,
+                  DuplicateKey policy) {
+    auto result = obj->emplace(std::piecewise_construct,
+                               std::forward_as_tuple(std::move(key)),
+                               std::forward_as_tuple());
+    if (!result.second) {
+      if (policy == DuplicateKey::kError) return false;
+      if (policy == DuplicateKey::kKeepFirst) return true;
+    }
+    result.first->second = std::move_if_noexcept(value);
+    return true;
+  }
+};
+
+template <typename K, typename V, typename C, typename A>
+struct InsertTraits<std::map<K, V, C, A>>
+    : DefaultInsertTraits<std::map<K, V, C, A>> {};
+template <typename K, typename V, typename H, typename E, typename A>
+struct InsertTraits<std::unordered_map<K, V, H, E, A>>
+    : DefaultInsertTraits<std::unordered_map<K, V, H, E, A>> {};
+template <typename K, typename V, typename H, typename E, typename A>
+struct InsertTraits<absl::flat_hash_map<K, V, H, E, A>>
+    : DefaultInsertTraits<absl::flat_hash_map<K, V, H, E, A>> {};
 
 // The rules for FormatTraits are:
 // 1. If fmtlib is found, use its functionality.
@@ -262,6 +428,18 @@ struct FormatTraits : internal::DefaultFormatTraits<T> {};
 // String.
 template <>
 struct MetaTypeOf<std::string, void> : MetaTypeContant<MetaTypes::kString> {};
+template <>
+struct MetaTypeOf<absl::string_view, void>
+    : MetaTypeContant<MetaTypes::kString> {};
+
+// Tells whether a T parsed from a string refers to the string instead of
+// copying it, like absl::string_view. Such a T points into the command line,
+// so it can only be parsed from one that outlives it (see ArgStorage).
+// Specialize it for your own view types.
+template <typename T>
+struct IsViewType : std::false_type {};
+template <>
+struct IsViewType<absl::string_view> : std::true_type {};
 
 // Bool.
 template <>
@@ -271,6 +449,81 @@ struct MetaTypeOf<bool, void> : MetaTypeContant<MetaTypes::kBool> {};
 template <>
 struct MetaTypeOf<char, void> : MetaTypeContant<MetaTypes::kChar> {};
 
+// Duration and byte size, e.g., "1h30m" and "4GiB".
+template <typename T>
+struct MetaTypeOf<T, absl::enable_if_t<internal::IsDuration<T>{}>>
+    : MetaTypeContant<MetaTypes::kDuration> {};
+template <>
+struct MetaTypeOf<internal::ByteSize, void>
+    : MetaTypeContant<MetaTypes::kBytes> {};
+
+template <typename Rep, typename Period>
+struct FormatTraits<std::chrono::duration<Rep, Period>> {
+  static std::string Run(std::chrono::duration<Rep, Period> value) {
+    return internal::units_internal::FormatDuration(value);
+  }
+};
+template <>
+struct FormatTraits<internal::ByteSize> {
+  static std::string Run(internal::ByteSize value) {
+    return internal::units_internal::FormatByteSize(value.bytes);
+  }
+};
+
+// Range sets, e.g., "0-63,128-191".
+template <>
+struct MetaTypeOf<internal::RangeSet, void>
+    : MetaTypeContant<MetaTypes::kRanges> {};
+template <>
+struct FormatTraits<internal::RangeSet> {
+  static std::string Run(const internal::RangeSet& value) {
+    return value.Format();
+  }
+};
+#if ARGPARSE_INTERNAL_HAS_CPU_SET
+template <>
+struct MetaTypeOf<cpu_set_t, void> : MetaTypeContant<MetaTypes::kRanges> {};
+template <>
+struct FormatTraits<cpu_set_t> {
+  static std::string Run(const cpu_set_t& value) {
+    return internal::range_set_internal::FormatCpuSet(value);
+  }
+};
+#endif  // ARGPARSE_INTERNAL_HAS_CPU_SET
+
+// Network addresses, e.g., "10.0.0.1", "[::1]:8080" and "10.0.0.0/8".
+template <>
+struct MetaTypeOf<internal::IpAddress, void>
+    : MetaTypeContant<MetaTypes::kAddress> {};
+template <>
+struct MetaTypeOf<internal::HostPort, void>
+    : MetaTypeContant<MetaTypes::kHostPort> {};
+template <>
+struct MetaTypeOf<internal::IpPrefix, void>
+    : MetaTypeContant<MetaTypes::kCidr> {};
+template <>
+struct FormatTraits<internal::IpAddress> {
+  static std::string Run(internal::IpAddress value) { return value.Format(); }
+};
+template <>
+struct FormatTraits<internal::HostPort> {
+  static std::string Run(const internal::HostPort& value) {
+    return value.Format();
+  }
+};
+template <>
+struct FormatTraits<internal::IpPrefix> {
+  static std::string Run(const internal::IpPrefix& value) {
+    return value.Format();
+  }
+};
+template <>
+struct FormatTraits<internal::IpPrefixTable> {
+  static std::string Run(const internal::IpPrefixTable& value) {
+    return value.Format();
+  }
+};
+
 // File.
 template <typename T>
 struct MetaTypeOf<T, absl::enable_if_t<internal::IsOpenSupported<T>{}>>
@@ -281,6 +534,21 @@ template <typename T>
 struct MetaTypeOf<T, absl::enable_if_t<internal::IsAppendSupported<T>{}>>
     : MetaTypeContant<MetaTypes::kList> {};
 
+// Tuple.
+template <typename T>
+struct MetaTypeOf<T, absl::enable_if_t<internal::IsTupleType<T>{}>>
+    : MetaTypeContant<MetaTypes::kTuple> {};
+
+// Array.
+template <typename T>
+struct MetaTypeOf<T, absl::enable_if_t<internal::IsFixedCapacity<T>{}>>
+    : MetaTypeContant<MetaTypes::kArray> {};
+
+// Map.
+template <typename T>
+struct MetaTypeOf<T, absl::enable_if_t<internal::IsInsertSupported<T>{}>>
+    : MetaTypeContant<MetaTypes::kMap> {};
+
 // Number.
 template <typename T>
 struct MetaTypeOf<T, absl::enable_if_t<internal::IsNumericType<T>{}>>
@@ -5,7 +5,10 @@
 
 #pragma once
 
-#include "absl/memory/memory.h"
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
 #include "absl/meta/type_traits.h"
 #include "absl/utility/utility.h"
 #include "argparse/internal/argparse-logging.h"
@@ -14,24 +17,80 @@ namespace argparse {
 namespace internal {
 namespace any_internal {
 
+template <typename T>
+class AnyImpl;
+
 // Our version of any.
-class Any {
+// Small types that can be moved without throwing are stored inline, so that
+// the common values (bool, int, double, pointers) never touch the heap. The
+// rest is allocated on the heap and only the pointer is moved around.
+// An Any can be empty (default-constructed or moved-from).
+class Any final {
  public:
-  ~Any() {
-    ARGPARSE_INTERNAL_DCHECK(destructor_func_, "");
-    destructor_func_(this);
+  Any() = default;
+  Any(Any&& that) noexcept { MoveFrom(&that); }
+  Any& operator=(Any&& that) noexcept {
+    if (this != &that) {
+      Reset();
+      MoveFrom(&that);
+    }
+    return *this;
   }
+  Any(const Any&) = delete;
+  Any& operator=(const Any&) = delete;
+  ~Any() { Reset(); }
 
   template <typename T>
   bool TypeIs() const;
 
- protected:
-  using DestructorFunc = void (*)(Any*);
-  explicit Any(DestructorFunc dtor) : destructor_func_(dtor) {}
-  DestructorFunc destructor_func() const { return destructor_func_; }
+  bool HasValue() const { return type_ops_ != nullptr; }
+  explicit operator bool() const { return HasValue(); }
+
+  // Destroy the held value, if any, and become empty.
+  void Reset() {
+    if (!type_ops_) return;
+    type_ops_->relocate_or_destroy(this, nullptr);
+    type_ops_ = nullptr;
+  }
+
+  // Return the size of the heap allocation holding the value, or 0 if it is
+  // empty or stored inline. What the value itself allocates is not included.
+  std::size_t GetHeapSize() const {
+    return type_ops_ ? type_ops_->heap_size : 0;
+  }
+
+  // The size and alignment of the inline buffer.
+  static constexpr std::size_t kInlineSize = 3 * sizeof(void*);
+  static constexpr std::size_t kInlineAlign = alignof(void*);
 
  private:
-  DestructorFunc destructor_func_;
+  template <typename T>
+  friend class AnyImpl;
+
+  // There is one TypeOps per type, so its address also serves as the type
+  // tag.
+  struct TypeOps {
+    // Destroy the value held by `self`. If `relocate_to` is not null, the
+    // value is moved there first.
+    void (*relocate_or_destroy)(Any* self, Any* relocate_to);
+    // sizeof(T) if T is on the heap, 0 if it is inline.
+    std::size_t heap_size;
+  };
+
+  void MoveFrom(Any* that) {
+    if (!that->type_ops_) return;
+    that->type_ops_->relocate_or_destroy(that, this);
+    type_ops_ = that->type_ops_;
+    that->type_ops_ = nullptr;
+  }
+
+  union Storage {
+    void* heap;
+    typename std::aligned_storage<kInlineSize, kInlineAlign>::type buffer;
+  };
+
+  Storage storage_;
+  const TypeOps* type_ops_ = nullptr;
 };
 
 template <typename T, typename... Args>
@@ -44,99 +103,122 @@ void DestroyAt(T* p) {
   p->~T();
 }
 
+// Whether a T is stored in the inline buffer of Any.
+template <typename T>
+struct IsStoredInline
+    : std::integral_constant<bool,
+                             sizeof(T) <= Any::kInlineSize &&
+                                 alignof(T) <= Any::kInlineAlign &&
+                                 std::is_nothrow_move_constructible<T>::value> {
+};
+
+// Type-specific operations on an Any that holds a T.
 template <typename T>
-class AnyImpl final : public Any {
+class AnyImpl final {
  private:
   static_assert(!std::is_array<T>::value, "T must not be array type");
+  using Inline = IsStoredInline<T>;
 
  public:
   template <typename... Args>
-  explicit AnyImpl(absl::in_place_t, Args&&... args)
-      : Any(GetDestructorFunc()) {
-    ConstructAt(GetPtr(), std::forward<Args>(args)...);
+  static void Construct(Any* self, Args&&... args) {
+    ARGPARSE_INTERNAL_DCHECK(!self->HasValue(), "Construct(): Any not empty");
+    ConstructImpl(Inline{}, self, std::forward<Args>(args)...);
+    self->type_ops_ = GetTypeOps();
   }
 
-  T* GetPtr() & { return reinterpret_cast<T*>(&storage_); }
-  const T* GetConstPtr() const& {
-    return reinterpret_cast<const T*>(&storage_);
-  }
-  T& GetRef() & { return *GetPtr(); }
-  const T& GetConstRef() const& { return *GetConstPtr(); }
-  T&& GetRValueRef() && { return std::move(GetRef()); }
-  const T&& GetRValueConstRef() const&& { return std::move(GetConstRef()); }
-
-  static AnyImpl* FromPtr(Any* self) {
-    ARGPARSE_INTERNAL_DCHECK(self, "Nullptr passed to FromPtr()");
-    ARGPARSE_INTERNAL_DCHECK(self->TypeIs<T>(), "FromPtr(): Type mismatched");
-    return static_cast<AnyImpl*>(self);
+  static T* GetPtr(Any* self) {
+    ARGPARSE_INTERNAL_DCHECK(self, "Nullptr passed to GetPtr()");
+    ARGPARSE_INTERNAL_DCHECK(self->TypeIs<T>(), "GetPtr(): Type mismatched");
+    return GetPtrImpl(Inline{}, self);
   }
 
-  static const AnyImpl* FromConstPtr(const Any* self) {
-    return FromPtr(const_cast<Any*>(self));
+  static const T* GetConstPtr(const Any* self) {
+    return GetPtr(const_cast<Any*>(self));
   }
 
-  static AnyImpl& FromRef(Any& self) {
-    return *FromPtr(&self);  //
-  }
+  static constexpr const Any::TypeOps* GetTypeOps() { return &kTypeOps; }
 
-  static const AnyImpl& FromConstRef(const Any& self) {
-    return FromRef(const_cast<Any&>(self));
+ private:
+  template <typename... Args>
+  static void ConstructImpl(std::true_type, Any* self, Args&&... args) {
+    ConstructAt(GetPtrImpl(std::true_type{}, self),
+                std::forward<Args>(args)...);
   }
-
-  static AnyImpl&& FromRValueRef(Any&& self) {
-    return std::move(FromRef(self));
+  template <typename... Args>
+  static void ConstructImpl(std::false_type, Any* self, Args&&... args) {
+    self->storage_.heap = new T{std::forward<Args>(args)...};
   }
 
-  static const AnyImpl&& FromRValueConstRef(const Any&& self) {
-    return std::move(FromConstRef(self));
+  static T* GetPtrImpl(std::true_type, Any* self) {
+    return reinterpret_cast<T*>(&self->storage_.buffer);
   }
-
-  static constexpr DestructorFunc GetDestructorFunc() {
-    return &DestructorFuncImpl;
+  static T* GetPtrImpl(std::false_type, Any* self) {
+    return static_cast<T*>(self->storage_.heap);
   }
 
- private:
-  static void DestructorFuncImpl(Any* self) {
-    DestroyAt(FromPtr(self)->GetPtr());
+  static void RelocateOrDestroyImpl(Any* self, Any* relocate_to) {
+    RelocateOrDestroy(Inline{}, self, relocate_to);
   }
 
-  typename std::aligned_storage<sizeof(T), alignof(T)>::type storage_;
+  static constexpr Any::TypeOps kTypeOps = {&RelocateOrDestroyImpl,
+                                            Inline::value ? 0 : sizeof(T)};
+
+  static void RelocateOrDestroy(std::true_type, Any* self, Any* relocate_to) {
+    T* ptr = GetPtrImpl(std::true_type{}, self);
+    if (relocate_to) {
+      ::new (GetPtrImpl(std::true_type{}, relocate_to)) T(std::move(*ptr));
+    }
+    DestroyAt(ptr);
+  }
+  static void RelocateOrDestroy(std::false_type, Any* self, Any* relocate_to) {
+    // Only the pointer changes hands, T itself is never moved.
+    if (relocate_to) {
+      relocate_to->storage_.heap = self->storage_.heap;
+    } else {
+      delete GetPtrImpl(std::false_type{}, self);
+    }
+  }
 };
 
+template <typename T>
+constexpr Any::TypeOps AnyImpl<T>::kTypeOps;
+
 template <typename T>
 bool Any::TypeIs() const {
-  return destructor_func() == AnyImpl<T>::GetDestructorFunc();
+  return type_ops_ == AnyImpl<T>::GetTypeOps();
 }
 
 template <typename T, typename... Args>
-std::unique_ptr<Any> MakeAny(Args&&... args) {
-  return absl::make_unique<AnyImpl<T>>(absl::in_place,
-                                       std::forward<Args>(args)...);
+Any MakeAny(Args&&... args) {
+  Any any;
+  AnyImpl<T>::Construct(&any, std::forward<Args>(args)...);
+  return any;
 }
 
 template <typename T>
 const T& AnyCast(const Any& any) {
-  return AnyImpl<T>::FromConstRef(any).GetConstRef();
+  return *AnyImpl<T>::GetConstPtr(&any);
 }
 
 template <typename T>
 T& AnyCast(Any& any) {
-  return AnyImpl<T>::FromRef(any).GetRef();
+  return *AnyImpl<T>::GetPtr(&any);
 }
 
 template <typename T>
 const T* AnyCast(const Any* any) {
-  return AnyImpl<T>::FromConstPtr(any)->GetConstPtr();
+  return AnyImpl<T>::GetConstPtr(any);
 }
 
 template <typename T>
 T* AnyCast(Any* any) {
-  return AnyImpl<T>::FromPtr(any)->GetPtr();
+  return AnyImpl<T>::GetPtr(any);
 }
 
 template <typename T>
 T&& AnyCast(Any&& any) {
-  return AnyImpl<T>::FromRValueRef(std::move(any)).GetRValueRef();
+  return std::move(*AnyImpl<T>::GetPtr(&any));
 }
 
 }  // namespace any_internal
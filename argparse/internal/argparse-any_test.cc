@@ -24,8 +24,8 @@ TYPED_TEST_SUITE(AnyTest, AnyTestTypes);
 
 TYPED_TEST(AnyTest, TypeIs) {
   auto any = MakeAny<TypeParam>();
-  EXPECT_TRUE(any->template TypeIs<TypeParam>());
-  EXPECT_FALSE(any->template TypeIs<SomeType>());
+  EXPECT_TRUE(any.template TypeIs<TypeParam>());
+  EXPECT_FALSE(any.template TypeIs<SomeType>());
 }
 
 TYPED_TEST(AnyTest, MakeAny) {
@@ -37,8 +37,16 @@ TYPED_TEST(AnyTest, AnyCast) {
   TypeParam default_value{};
   auto any = MakeAny<TypeParam>();
 
-  EXPECT_EQ(AnyCast<TypeParam>(*any), default_value);
-  EXPECT_EQ(*AnyCast<TypeParam>(any.get()), default_value);
+  EXPECT_EQ(AnyCast<TypeParam>(any), default_value);
+  EXPECT_EQ(*AnyCast<TypeParam>(&any), default_value);
+}
+
+TYPED_TEST(AnyTest, MoveKeepsValue) {
+  auto any = MakeAny<TypeParam>();
+  Any other(std::move(any));
+  EXPECT_FALSE(any);
+  EXPECT_TRUE(other.template TypeIs<TypeParam>());
+  EXPECT_EQ(AnyCast<TypeParam>(other), TypeParam{});
 }
 
 TEST(NonTypedAnyTest, DestructorDidRun) {
@@ -52,16 +60,68 @@ TEST(NonTypedAnyTest, DestructorDidRun) {
 
   bool value = false;
   auto any = MakeAny<FlipWhenDtorRun>(&value);
-  any.reset();
+  any.Reset();
   EXPECT_TRUE(value);
+  EXPECT_FALSE(any);
 }
 
 TEST(NonTypedAnyTest, CanHoldMoveOnlyType) {
   using MoveOnly = std::ostringstream;
   auto any = MakeAny<MoveOnly>();
   constexpr auto kDataToStream = "Data";
-  AnyCast<MoveOnly>(*any) << kDataToStream;
-  EXPECT_EQ(AnyCast<MoveOnly>(*any).str(), kDataToStream);
+  AnyCast<MoveOnly>(any) << kDataToStream;
+  EXPECT_EQ(AnyCast<MoveOnly>(any).str(), kDataToStream);
+}
+
+TEST(NonTypedAnyTest, DefaultCtorIsEmpty) {
+  Any any;
+  EXPECT_FALSE(any);
+  EXPECT_FALSE(any.TypeIs<int>());
+}
+
+TEST(NonTypedAnyTest, SmallTypesAreStoredInline) {
+  static_assert(any_internal::IsStoredInline<bool>::value, "");
+  static_assert(any_internal::IsStoredInline<int>::value, "");
+  static_assert(any_internal::IsStoredInline<double>::value, "");
+  static_assert(any_internal::IsStoredInline<void*>::value, "");
+
+  auto any = MakeAny<int>(1);
+  auto* storage_begin = reinterpret_cast<char*>(&any);
+  auto* value_ptr = reinterpret_cast<char*>(AnyCast<int>(&any));
+  EXPECT_TRUE(storage_begin <= value_ptr &&
+              value_ptr < storage_begin + sizeof(Any));
+}
+
+TEST(NonTypedAnyTest, LargeOrThrowingMoveTypesAreOnHeap) {
+  struct Large {
+    char data[Any::kInlineSize + 1];
+  };
+  struct ThrowingMove {
+    ThrowingMove() = default;
+    ThrowingMove(ThrowingMove&&) noexcept(false) {}
+  };
+  static_assert(!any_internal::IsStoredInline<Large>::value, "");
+  static_assert(!any_internal::IsStoredInline<ThrowingMove>::value, "");
+
+  // Moving a heap value only moves the pointer.
+  auto any = MakeAny<Large>();
+  auto* value_ptr = AnyCast<Large>(&any);
+  Any other(std::move(any));
+  EXPECT_EQ(AnyCast<Large>(&other), value_ptr);
+}
+
+TEST(NonTypedAnyTest, MoveAssignDestroysOldValue) {
+  struct FlipWhenDtorRun {
+    bool* value_outside_;
+    ~FlipWhenDtorRun() {
+      if (value_outside_) *value_outside_ = !*value_outside_;
+    }
+  };
+  bool value = false;
+  auto any = MakeAny<FlipWhenDtorRun>(&value);
+  any = MakeAny<int>(1);
+  EXPECT_TRUE(value);
+  EXPECT_EQ(AnyCast<int>(any), 1);
 }
 
 // TYPED_TEST(AnyTest, TakeValueAndDiscard) {
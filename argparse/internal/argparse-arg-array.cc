@@ -0,0 +1,85 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "argparse/internal/argparse-arg-array.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+#include "argparse/internal/argparse-logging.h"
+
+namespace argparse {
+namespace internal {
+
+ArgvBuffer::ArgvBuffer(ArgArray args) : args_(args) {
+  if (auto* c_strings = args.GetCStrings()) {
+    // The backends never write to the strings.
+    argv_ = const_cast<char**>(c_strings);
+    return;
+  }
+  pointers_.reserve(args.size() + 1);
+  if (args.IsNulTerminated()) {
+    for (std::size_t i = 0; i < args.size(); ++i)
+      pointers_.push_back(const_cast<char*>(args[i].data()));
+  } else {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < args.size(); ++i) total += args[i].size() + 1;
+    buffer_.reserve(total);
+    offsets_.reserve(args.size());
+    for (std::size_t i = 0; i < args.size(); ++i) {
+      offsets_.push_back(buffer_.size());
+      buffer_.append(args[i].data(), args[i].size());
+      buffer_.push_back('\0');
+    }
+    // The buffer is never reallocated from now on.
+    for (auto offset : offsets_) pointers_.push_back(&buffer_[offset]);
+  }
+  // Like the argv of main().
+  pointers_.push_back(nullptr);
+  argv_ = pointers_.data();
+}
+
+absl::string_view ArgvBuffer::MapBack(absl::string_view value) const {
+  if (offsets_.empty() || value.data() < buffer_.data() ||
+      value.data() >= buffer_.data() + buffer_.size())
+    return value;
+  auto offset = static_cast<std::size_t>(value.data() - buffer_.data());
+  auto index = std::upper_bound(offsets_.begin(), offsets_.end(), offset) -
+               offsets_.begin() - 1;
+  return args_[index].substr(offset - offsets_[index], value.size());
+}
+
+void ArgvBuffer::FindIndices(absl::Span<char* const> tokens,
+                             std::vector<int>* indices) const {
+  // Sorted by address, then by index, so a pointer given twice takes its
+  // indices in turn.
+  using Slot = std::pair<std::uintptr_t, int>;
+  std::vector<Slot> slots;
+  slots.reserve(GetArgc());
+  for (int i = 0; i < GetArgc(); ++i)
+    slots.emplace_back(reinterpret_cast<std::uintptr_t>(argv_[i]), i);
+  std::sort(slots.begin(), slots.end());
+  std::vector<bool> used(slots.size());
+  auto first = indices->size();
+  for (auto* token : tokens) {
+    auto address = reinterpret_cast<std::uintptr_t>(token);
+    auto pos = static_cast<std::size_t>(
+        std::lower_bound(slots.begin(), slots.end(), Slot(address, 0)) -
+        slots.begin());
+    while (pos < slots.size() && slots[pos].first == address && used[pos])
+      ++pos;
+    if (pos == slots.size() || slots[pos].first != address) {
+      ARGPARSE_INTERNAL_DCHECK(false, "Not a token of argv");
+      continue;
+    }
+    used[pos] = true;
+    indices->push_back(slots[pos].second);
+  }
+  std::sort(indices->begin() + first, indices->end());
+}
+
+}  // namespace internal
+}  // namespace argparse
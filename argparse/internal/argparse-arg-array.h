@@ -5,8 +5,11 @@
 
 #pragma once
 
+#include <cstddef>
+#include <string>
 #include <vector>
 
+#include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 
 namespace argparse {
@@ -14,24 +17,123 @@ namespace internal {
 
 using ArgVector = std::vector<const char*>;
 
-class ArgArray final : private absl::Span<const char*> {
-  using Base = absl::Span<const char*>;
+// Whether the strings of the command line outlive the dests they are parsed
+// into. Only persistent strings can be bound to dests that refer to them, like
+// absl::string_view.
+enum class ArgStorage {
+  // The strings may go away after the parse call.
+  kTransient,
+  // The strings live as long as the dests, e.g., the argv of main().
+  kPersistent,
+};
 
+// A view of the tokens of a command line. The tokens can be C strings (like
+// the argv of main()), std::strings or string_views, and are read as
+// string_views without any copy. Backends that need a char** (argp, gflags)
+// get one from ArgvBuffer.
+class ArgArray final {
  public:
-  // Constructed from a pair.
-  ArgArray(int argc, const char** argv) : Base(absl::MakeSpan(argv, argc)) {}
+  // Constructed from a pair. This is normally the argv of main(), which lives
+  // until the program exits.
+  ArgArray(int argc, const char** argv,
+           ArgStorage storage = ArgStorage::kPersistent)
+      : kind_(kCStrings), size_(argc), storage_(storage) {
+    data_.c_strings = argv;
+  }
+
+  // The strings a vector points to often are temporaries.
+  ArgArray(ArgVector& vector, ArgStorage storage = ArgStorage::kTransient)
+      : ArgArray(static_cast<int>(vector.size()), vector.data(), storage) {}
 
-  ArgArray(ArgVector& vector) : Base(absl::MakeSpan(vector)) {}
+  ArgArray(absl::Span<const absl::string_view> views,
+           ArgStorage storage = ArgStorage::kTransient)
+      : kind_(kViews), size_(views.size()), storage_(storage) {
+    data_.views = views.data();
+  }
+
+  ArgArray(const std::vector<std::string>& strings,
+           ArgStorage storage = ArgStorage::kTransient)
+      : kind_(kStrings), size_(strings.size()), storage_(storage) {
+    data_.strings = strings.data();
+  }
 
   ArgArray(const ArgArray&) = default;
   ArgArray& operator=(const ArgArray&) = default;
 
-  int GetArgc() const { return static_cast<int>(Base::size()); }
-  char** GetArgv() const { return const_cast<char**>(Base::data()); }
+  int GetArgc() const { return static_cast<int>(size_); }
+  std::size_t size() const { return size_; }
+  ArgStorage GetStorage() const { return storage_; }
+
+  absl::string_view operator[](std::size_t i) const {
+    switch (kind_) {
+      case kCStrings:
+        return data_.c_strings[i];
+      case kStrings:
+        return data_.strings[i];
+      default:
+        return data_.views[i];
+    }
+  }
+
+  // The C strings this was constructed from, or null.
+  const char* const* GetCStrings() const {
+    return kind_ == kCStrings ? data_.c_strings : nullptr;
+  }
+
+  // Whether each token is followed by a NUL, so a backend can use it as a C
+  // string in place.
+  bool IsNulTerminated() const { return kind_ != kViews; }
+
+ private:
+  enum Kind { kCStrings, kStrings, kViews };
+
+  union Data {
+    const char** c_strings;
+    const std::string* strings;
+    const absl::string_view* views;
+  };
+
+  Kind kind_;
+  Data data_;
+  std::size_t size_;
+  ArgStorage storage_;
+};
+
+// The char** form of an ArgArray, for the backends written in C. The C
+// strings of the array are used as they are. The pointers of std::strings are
+// collected, and only string_views, which need not end with a NUL, are copied
+// (into a single buffer).
+class ArgvBuffer final {
+ public:
+  explicit ArgvBuffer(ArgArray args);
+
+  ArgvBuffer(const ArgvBuffer&) = delete;
+  ArgvBuffer& operator=(const ArgvBuffer&) = delete;
+
+  int GetArgc() const { return args_.GetArgc(); }
+  // The backend may permute the pointers (argp does), but not the strings.
+  char** GetArgv() { return argv_; }
+
+  // Map `value`, which points into a token of GetArgv(), back into the same
+  // token of the ArgArray. This keeps dests bound to the command line (like
+  // absl::string_view) pointing to the caller's strings.
+  absl::string_view MapBack(absl::string_view value) const;
+
+  // Append to `indices` the index of each of `tokens`, which are pointers of
+  // GetArgv() that a backend left in any order (gflags puts the ones after
+  // "--" first). A pointer that occurs n times in argv can be given n times.
+  // The indices are appended in ascending order.
+  void FindIndices(absl::Span<char* const> tokens,
+                   std::vector<int>* indices) const;
 
-  using Base::begin;
-  using Base::end;
-  using Base::operator[];
+ private:
+  ArgArray args_;
+  char** argv_ = nullptr;
+  std::vector<char*> pointers_;
+  // The copies of the tokens, each ending with a NUL.
+  std::string buffer_;
+  // offsets_[i] is where the copy of token i begins in buffer_.
+  std::vector<std::size_t> offsets_;
 };
 
 }  // namespace internal
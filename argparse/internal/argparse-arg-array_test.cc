@@ -0,0 +1,98 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "argparse/internal/argparse-arg-array.h"
+
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_split.h"
+#include "argparse/argparse-builder.h"
+#include "gtest/gtest.h"
+
+namespace argparse {
+namespace internal {
+namespace testing_internal {
+
+TEST(ArgArray, ReadsEachKindOfToken) {
+  const char* c_strings[] = {"prog", "--flag"};
+  std::vector<std::string> strings = {"prog", "--flag"};
+  std::vector<absl::string_view> views = {"prog", "--flag"};
+  for (auto args : {ArgArray(2, c_strings), ArgArray(strings),
+                    ArgArray(absl::MakeConstSpan(views))}) {
+    ASSERT_EQ(args.size(), 2);
+    EXPECT_EQ(args[1], "--flag");
+  }
+  EXPECT_EQ(ArgArray(strings)[1].data(), strings[1].data());
+}
+
+TEST(ArgvBuffer, UsesCStringsInPlace) {
+  const char* argv[] = {"prog", "--flag"};
+  ArgvBuffer buffer(ArgArray(2, argv));
+  EXPECT_EQ(buffer.GetArgv(), const_cast<char**>(argv));
+}
+
+TEST(ArgvBuffer, PointsIntoStrings) {
+  std::vector<std::string> strings = {"prog", "--flag"};
+  ArgvBuffer buffer{ArgArray(strings)};
+  EXPECT_EQ(buffer.GetArgv()[1], strings[1].data());
+  EXPECT_EQ(buffer.GetArgv()[2], nullptr);
+}
+
+TEST(ArgvBuffer, CopiesViewsAndMapsBack) {
+  std::string line = "prog--flag=value";
+  std::vector<absl::string_view> views = {absl::string_view(line).substr(0, 4),
+                                          absl::string_view(line).substr(4)};
+  ArgvBuffer buffer{ArgArray(absl::MakeConstSpan(views))};
+  EXPECT_STREQ(buffer.GetArgv()[0], "prog");
+  EXPECT_STREQ(buffer.GetArgv()[1], "--flag=value");
+
+  absl::string_view value(buffer.GetArgv()[1] + 7, 5);
+  auto original = buffer.MapBack(value);
+  EXPECT_EQ(original, "value");
+  EXPECT_EQ(original.data(), line.data() + 11);
+}
+
+TEST(ArgvBuffer, FindIndicesInAnyOrder) {
+  // The same literal may be given twice.
+  const char* kSame = "a";
+  const char* argv[] = {"prog", kSame, "--x=1", "--", "b", kSame};
+  ArgvBuffer buffer(ArgArray(6, argv));
+  auto* pointers = buffer.GetArgv();
+  // Like gflags leaves them: those after "--" first.
+  char* left[] = {pointers[4], pointers[5], pointers[1]};
+  std::vector<int> indices = {0};
+  buffer.FindIndices(left, &indices);
+  EXPECT_EQ(indices, (std::vector<int>{0, 1, 4, 5}));
+}
+
+// gflags has no append action, and exits on the unknown flag.
+#ifdef ARGPARSE_USE_ARGP
+TEST(ArgArray, ParseStringsWithoutArgv) {
+  int num = 0;
+  std::vector<absl::string_view> names;
+  argparse::ArgumentParser parser;
+  parser.AddArgument(argparse::Argument("--num", &num));
+  parser.AddArgument(argparse::Argument("--name", &names).Action("append"));
+
+  std::string line = "prog --num=1 --name=a extra";
+  std::vector<absl::string_view> tokens = absl::StrSplit(line, ' ');
+  std::vector<int> unknown;
+  auto status = parser.TryParseKnownArgs(
+      ArgArray(absl::MakeConstSpan(tokens), ArgStorage::kPersistent),
+      &unknown);
+  EXPECT_TRUE(status.ok()) << status;
+  EXPECT_EQ(num, 1);
+  ASSERT_EQ(names.size(), 1);
+  // Bound to the line, not to a copy of it.
+  EXPECT_EQ(names[0].data(), line.data() + 20);
+  EXPECT_EQ(unknown, std::vector<int>{3});
+}
+
+#endif  // ARGPARSE_USE_ARGP
+
+}  // namespace testing_internal
+}  // namespace internal
+}  // namespace argparse
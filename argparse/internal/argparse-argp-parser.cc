@@ -5,20 +5,43 @@
 
 #include "argparse/internal/argparse-argp-parser.h"
 
+#include <algorithm>
 #include <cstring>
 
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
 #include "argparse/internal/argparse-argument-container.h"
 
 namespace argparse {
 namespace internal {
 namespace argp_parser_internal {
 
+constexpr int ArgpParser::kFirstOptionKey;
+
 namespace {
 
 // I'm afraid there is some tricky magic about initializing a C struct to 0 in
 // C++. So this abstraction should work for all cases.
 constexpr struct argp_option EmptyOption() { return {0}; }
 
+// Shown for an option that takes a value but has no metavar.
+constexpr char kDefaultMetaVar[] = "VALUE";
+
+// The long options argp always adds, besides --version, and whether each of
+// them takes a value.
+constexpr std::pair<const char*, bool> kArgpLongOptions[] = {
+    {"help", false},
+    {"usage", false},
+    {"program-name", true},
+    {"HANG", false},
+};
+
+// The number of values a positional takes, unless it TakesMany().
+std::size_t GetFixedCount(const Argument* arg) {
+  auto* num_args = arg->GetNumArgs();
+  return num_args && num_args->GetCount() > 1 ? num_args->GetCount() : 1;
+}
+
 }  // namespace
 
 ArgpParser::ArgpParser() {
@@ -35,6 +58,21 @@ ArgpParser::~ArgpParser() {
   argp_program_bug_address = nullptr;
 }
 
+void ArgpParser::AddMemoryUsage(MemoryUsage* usage) const {
+  usage->AddObject(*this);
+  usage->AddBuffer(description_);
+  usage->AddBuffer(program_version_);
+  usage->AddBuffer(program_name_);
+  usage->AddBuffer(bug_address_);
+  usage->AddBuffer(options_);
+  usage->AddBuffer(optional_args_);
+  usage->AddBuffer(positional_args_);
+  usage->AddBuffer(positional_slots_);
+  usage->AddBuffer(many_values_);
+  usage->AddBuffer(long_options_);
+  usage->AddBuffer(token_indices_);
+}
+
 void ArgpParser::AppendGroupOption(ArgumentGroup* group) {
   auto option = EmptyOption();
   option.group = next_group_id_++;
@@ -48,14 +86,20 @@ void ArgpParser::AppendPositionalArgument(Argument* arg) {
   option.name = arg->GetNames()->GetPositionalName().data();
   option.flags = OPTION_DOC;
   options_.push_back(option);
+  positional_args_.push_back(arg);
 }
 
 void ArgpParser::AppendOptionalArgument(Argument* arg) {
   auto option = EmptyOption();
   auto option_key = next_option_id_++;
-  optional_args_.insert({option_key, arg});
+  ARGPARSE_DCHECK(static_cast<std::size_t>(option_key - kFirstOptionKey) ==
+                  optional_args_.size());
+  optional_args_.push_back(arg);
 
-  option.arg = arg->GetMetaVar().data();
+  if (arg->GetAction()->ConsumesValue()) {
+    option.arg = arg->GetMetaVar().empty() ? kDefaultMetaVar
+                                           : arg->GetMetaVar().data();
+  }
   option.doc = arg->GetHelpDoc().data();
   option.key = option_key;
   option.name =
@@ -70,9 +114,16 @@ void ArgpParser::AppendArgument(Argument* arg) {
 
 void ArgpParser::Initialize(ArgumentContainer* container) {
   auto* main_holder = container->GetMainHolder();
+  // One option per argument and group, plus the terminating one.
   auto total_count = main_holder->GetTotalArgumentCount() +
-                     main_holder->GetArgumentGroupCount();
+                     main_holder->GetArgumentGroupCount() + 1;
+  options_.clear();
   options_.reserve(total_count);
+  optional_args_.clear();
+  optional_args_.reserve(main_holder->GetTotalArgumentCount());
+  positional_args_.clear();
+  next_option_id_ = kFirstOptionKey;
+  next_group_id_ = 1;
 
   for (size_t i = 0; i < main_holder->GetArgumentGroupCount(); ++i) {
     auto* group = main_holder->GetArgumentGroup(i);
@@ -86,6 +137,36 @@ void ArgpParser::Initialize(ArgumentContainer* container) {
 
   options_.push_back(EmptyOption());
   parser_.options = options_.data();
+
+  long_options_.assign(std::begin(kArgpLongOptions),
+                       std::end(kArgpLongOptions));
+  for (auto* arg : optional_args_) {
+    long_options_.emplace_back(
+        NamesInfo::StripPrefixChars(arg->GetNames()->GetOptionalName()),
+        arg->GetAction()->ConsumesValue());
+  }
+
+  positional_slots_.clear();
+  many_index_ = positional_args_.size();
+  trailing_count_ = 0;
+  for (std::size_t i = 0; i < positional_args_.size(); ++i) {
+    auto* arg = positional_args_[i];
+    if (arg->TakesMany()) {
+      ARGPARSE_CHECK_F(many_index_ == positional_args_.size(),
+                       "Only one positional can take '*' or '+' values, "
+                       "found '%s' after '%s'",
+                       arg->GetNames()->GetPositionalName().data(),
+                       positional_args_[many_index_]
+                           ->GetNames()
+                           ->GetPositionalName()
+                           .data());
+      many_index_ = i;
+    } else if (many_index_ == positional_args_.size()) {
+      positional_slots_.insert(positional_slots_.end(), GetFixedCount(arg), i);
+    } else {
+      trailing_count_ += GetFixedCount(arg);
+    }
+  }
 }
 
 void ArgpParser::SetOption(ParserOptions key, absl::string_view value) {
@@ -118,16 +199,201 @@ void ArgpParser::SetDescription(absl::string_view value) {
   description_ = static_cast<std::string>(value);
 }
 
-bool ArgpParser::ParseKnownArgs(ArgArray args, std::vector<std::string>* out) {
-  auto rv =
-      argp_parse(&parser_, args.GetArgc(), args.GetArgv(), 0, nullptr, this);
-  return !!rv;
+absl::Status ArgpParser::ParseKnownArgs(ArgArray args,
+                                        ParseBudgetTracker* budget,
+                                        std::vector<int>* unknown) {
+  budget_ = budget;
+  unknown_ = unknown;
+  status_ = absl::OkStatus();
+  // Without `unknown`, argp prints the error and exits. ARGP_IN_ORDER keeps
+  // argv from being permuted, so the indices of the tokens hold.
+  unsigned flags = ARGP_IN_ORDER;
+  if (unknown) flags |= ARGP_NO_EXIT | ARGP_NO_ERRS;
+  ArgvBuffer argv(args);
+  argv_ = &argv;
+  std::vector<char*> tokens(argv.GetArgv(), argv.GetArgv() + argv.GetArgc());
+  auto first_unknown = unknown ? unknown->size() : 0;
+  if (unknown) TakeUnknownOptions(&tokens);
+  many_values_.clear();
+  if (many_index_ < positional_args_.size() ||
+      positional_slots_.size() > many_index_)
+    many_values_.reserve(args.size());
+  auto rv = argp_parse(&parser_, static_cast<int>(tokens.size()),
+                       tokens.data(), flags, nullptr, this);
+  // The unknown options were taken out before the extra positionals.
+  if (unknown) std::sort(unknown->begin() + first_unknown, unknown->end());
+  budget_ = nullptr;
+  unknown_ = nullptr;
+  argv_ = nullptr;
+  if (!status_.ok()) return status_;
+  if (rv) return absl::InvalidArgumentError(std::strerror(rv));
+  return absl::OkStatus();
 }
 
-error_t ArgpParser::Parse(int key, char* arg, struct argp_state* state) {
+void ArgpParser::TakeUnknownOptions(std::vector<char*>* tokens) {
+  token_indices_.assign(1, 0);
+  std::size_t size = 1;
+  bool value_next = false;
+  bool options_end = false;
+  for (std::size_t i = 1; i < tokens->size(); ++i) {
+    absl::string_view token = (*tokens)[i];
+    if (value_next) {
+      value_next = false;
+    } else if (!options_end && token == "--") {
+      // The rest are positionals.
+      options_end = true;
+    } else if (!options_end && token.size() > 1 && token[0] == '-' &&
+               !IsKnownOption(token, &value_next)) {
+      unknown_->push_back(static_cast<int>(i));
+      continue;
+    }
+    (*tokens)[size++] = (*tokens)[i];
+    token_indices_.push_back(static_cast<int>(i));
+  }
+  tokens->resize(size);
+}
+
+bool ArgpParser::IsKnownOption(absl::string_view token,
+                               bool* value_next) const {
+  *value_next = false;
+  // Ours have no short names, so only "-?" and "-V" of argp are taken.
+  if (token[1] != '-')
+    return token == "-?" || (token == "-V" && argp_program_version);
+  auto name = token.substr(2);
+  auto equal = name.find('=');
+  name = name.substr(0, equal);
+  // getopt_long() takes the exact name, or else a prefix of only one name.
+  bool exact = false;
+  int prefix_count = 0;
+  bool takes_value = false;
+  auto consider = [&](absl::string_view option, bool option_takes_value) {
+    if (exact || !absl::StartsWith(option, name)) return;
+    exact = option == name;
+    prefix_count = exact ? 1 : prefix_count + 1;
+    takes_value = option_takes_value;
+  };
+  for (const auto& option : long_options_)
+    consider(option.first, option.second);
+  // argp adds --version only if there is a version to show.
+  if (argp_program_version) consider("version", false);
+  if (name.empty() || prefix_count != 1) return false;
+  *value_next = takes_value && equal == absl::string_view::npos;
+  return true;
+}
+
+error_t ArgpParser::RunArgument(Argument* arg, char* value,
+                                struct argp_state* state) {
+  // Give the value in the caller's strings, not in a copy made for argp.
+  absl::optional<absl::string_view> mapped;
+  if (value) mapped = argv_->MapBack(value);
+  return ReportError(arg->Run(mapped, budget_), state);
+}
+
+error_t ArgpParser::RunManyArgument(Argument* arg, struct argp_state* state) {
+  auto status = arg->RunMany(many_values_, budget_);
+  many_values_.clear();
+  return ReportError(std::move(status), state);
+}
+
+error_t ArgpParser::RunValues(Argument* arg,
+                              absl::Span<const absl::string_view> values,
+                              struct argp_state* state) {
+  if (GetFixedCount(arg) == 1)
+    return ReportError(arg->Run(values[0], budget_), state);
+  return ReportError(arg->RunMany(values, budget_), state);
+}
+
+error_t ArgpParser::EndPositionals(struct argp_state* state) {
+  auto slot = state->arg_num;
+  if (slot < positional_slots_.size()) {
+    auto index = positional_slots_[slot];
+    // One with a fixed count that got only some of its values.
+    if (!many_values_.empty())
+      return RunManyArgument(positional_args_[index], state);
+    return ReportMissing(index, state);
+  }
+  if (many_index_ == positional_args_.size()) return 0;
+  if (many_values_.size() < trailing_count_)
+    return ReportMissing(many_index_, state);
+  // The ones after the one that TakesMany() take the last values.
+  auto values = absl::MakeConstSpan(many_values_);
+  auto pos = values.size() - trailing_count_;
+  auto error = ReportError(
+      positional_args_[many_index_]->RunMany(values.first(pos), budget_),
+      state);
+  for (auto i = many_index_ + 1; !error && i < positional_args_.size(); ++i) {
+    auto count = GetFixedCount(positional_args_[i]);
+    error = RunValues(positional_args_[i], values.subspan(pos, count), state);
+    pos += count;
+  }
+  many_values_.clear();
+  return error;
+}
+
+error_t ArgpParser::ReportMissing(std::size_t first, struct argp_state* state) {
+  std::string names;
+  for (auto i = first; i < positional_args_.size(); ++i) {
+    auto* arg = positional_args_[i];
+    auto* num_args = arg->GetNumArgs();
+    std::string errmsg;
+    // Those of '?' and '*' may be left out, and the one that TakesMany() is
+    // run below.
+    if (i == many_index_ || (num_args && num_args->Run(0, &errmsg)))
+      continue;
+    absl::StrAppend(&names, names.empty() ? "" : ", ",
+                    arg->GetNames()->GetPositionalName());
+  }
+  if (!names.empty()) {
+    return ReportError(
+        absl::InvalidArgumentError(absl::StrCat(
+            "the following arguments are required: ", names)),
+        state);
+  }
+  // It got no value, which '+' doesn't allow.
+  if (many_index_ < positional_args_.size())
+    return RunManyArgument(positional_args_[many_index_], state);
   return 0;
 }
 
+error_t ArgpParser::ReportError(absl::Status status,
+                                struct argp_state* state) {
+  if (status.ok()) return 0;
+  status_ = std::move(status);
+  argp_error(state, "%s", std::string(status_.message()).c_str());
+  return absl::IsResourceExhausted(status_) ? ENOMEM : EINVAL;
+}
+
+error_t ArgpParser::Parse(int key, char* arg, struct argp_state* state) {
+  // The special keys of argp, like ARGP_KEY_END, are also large numbers.
+  auto index = static_cast<std::size_t>(key - kFirstOptionKey);
+  if (key >= kFirstOptionKey && index < optional_args_.size())
+    return RunArgument(optional_args_[index], arg, state);
+  if (key == ARGP_KEY_ARG) {
+    auto slot = state->arg_num;
+    // Collected and run in one go at the end.
+    if (slot >= positional_slots_.size() &&
+        many_index_ < positional_args_.size()) {
+      many_values_.push_back(argv_->MapBack(arg));
+      return 0;
+    }
+    if (slot < positional_slots_.size()) {
+      auto* positional = positional_args_[positional_slots_[slot]];
+      auto count = GetFixedCount(positional);
+      if (count == 1) return RunArgument(positional, arg, state);
+      // Run once all of its values are there.
+      many_values_.push_back(argv_->MapBack(arg));
+      if (many_values_.size() < count) return 0;
+      return RunManyArgument(positional, state);
+    }
+    if (!unknown_) return ARGP_ERR_UNKNOWN;
+    // An extra positional, which is at argv[next - 1] in order mode.
+    unknown_->push_back(token_indices_[state->next - 1]);
+    return 0;
+  }
+  if (key == ARGP_KEY_END) return EndPositionals(state);
+  return ARGP_ERR_UNKNOWN;
+}
+
 }  // namespace argp_parser_internal
 
 std::unique_ptr<ArgumentParser> ArgumentParser::CreateDefault() {
@@ -7,7 +7,9 @@
 
 #include <argp.h>
 
-#include "absl/container/flat_hash_map.h"
+#include <utility>
+#include <vector>
+
 #include "argparse/internal/argparse-argument-parser.h"
 
 namespace argparse {
@@ -21,8 +23,10 @@ class ArgpParser final : public ArgumentParser {
  public:
   ArgpParser();
   void Initialize(ArgumentContainer* container) override;
-  bool ParseKnownArgs(ArgArray args, std::vector<std::string>* out) override;
+  absl::Status ParseKnownArgs(ArgArray args, ParseBudgetTracker* budget,
+                              std::vector<int>* unknown) override;
   void SetOption(ParserOptions key, absl::string_view value) override;
+  void AddMemoryUsage(MemoryUsage* usage) const override;
 
   ~ArgpParser();
 
@@ -33,6 +37,29 @@ class ArgpParser final : public ArgumentParser {
 
   // Actual handling of each argument.
   error_t Parse(int key, char* arg, struct argp_state* state);
+  // Run `arg` with `value` and report the error to argp.
+  error_t RunArgument(Argument* arg, char* value, struct argp_state* state);
+  // Run a positional that takes several values with the ones collected for
+  // it.
+  error_t RunManyArgument(Argument* arg, struct argp_state* state);
+  // Run a positional with a fixed count on its `values`.
+  error_t RunValues(Argument* arg, absl::Span<const absl::string_view> values,
+                    struct argp_state* state);
+  // Run what is left at the end: the one that TakesMany() and those after
+  // it, or report the positionals that got too few values.
+  error_t EndPositionals(struct argp_state* state);
+  // Report the positionals from positional_args_[first] on that needed a
+  // value but got none.
+  error_t ReportMissing(std::size_t first, struct argp_state* state);
+  // Put an error of the parse into status_ and report it to argp.
+  error_t ReportError(absl::Status status, struct argp_state* state);
+  // Take the options that argp doesn't know, which would fail the whole
+  // parse, out of `tokens` and put their indices into unknown_. Fill
+  // token_indices_ for the tokens left.
+  void TakeUnknownOptions(std::vector<char*>* tokens);
+  // Whether getopt_long() would take `token`, like "--name=value". Set
+  // `*value_next` if the next token is its value.
+  bool IsKnownOption(absl::string_view token, bool* value_next) const;
 
   void AppendGroupOption(ArgumentGroup* group);
   void AppendArgument(Argument* arg);
@@ -41,16 +68,43 @@ class ArgpParser final : public ArgumentParser {
 
   using OptionVector = std::vector<struct argp_option>;
 
-  unsigned next_option_id_;
-  unsigned next_group_id_;
+  // Keys below this are taken by argp as short options.
+  static constexpr int kFirstOptionKey = 256;
+
+  int next_option_id_ = kFirstOptionKey;
+  int next_group_id_ = 1;
   std::string description_;
   std::string program_version_;
   std::string program_name_;
   std::string bug_address_;
   OptionVector options_;
-  absl::flat_hash_map<unsigned, Argument*> optional_args_;
+  // Keys are given out in order, so optional_args_[key - kFirstOptionKey] is
+  // the argument of an option.
+  std::vector<Argument*> optional_args_;
   std::vector<Argument*> positional_args_;
+  // The only positional that TakesMany(), or positional_args_.size(). It
+  // gets all the positional values from there on, except the last
+  // trailing_count_ ones, which go to the positionals after it.
+  std::size_t many_index_ = 0;
+  std::size_t trailing_count_ = 0;
+  // The index into positional_args_ of each positional value before the one
+  // that TakesMany(). A positional with a fixed count, like a tuple, has that
+  // many slots.
+  std::vector<std::size_t> positional_slots_;
+  // The values collected for a positional that takes several of them.
+  std::vector<absl::string_view> many_values_;
+  // The long options of argp, ours and its own, and whether each of them
+  // takes a value.
+  std::vector<std::pair<absl::string_view, bool>> long_options_;
   struct argp parser_;
+  // Set during ParseKnownArgs().
+  ParseBudgetTracker* budget_ = nullptr;
+  std::vector<int>* unknown_ = nullptr;
+  // The argv given to argp during a parse.
+  const ArgvBuffer* argv_ = nullptr;
+  // With unknown_, the index into the ArgArray of each token given to argp.
+  std::vector<int> token_indices_;
+  absl::Status status_;
 };
 
 }  // namespace argp_parser_internal
@@ -37,10 +37,16 @@ ActionKind ArgumentBuilder::StringToActions(absl::string_view str) {
   return iter->second;
 }
 
+void ArgumentBuilder::SetOptionalNames(absl::Span<const SpecString> names) {
+  absl::InlinedVector<absl::string_view, 2> resolved;
+  for (const auto& name : names) resolved.push_back(ResolveString(name));
+  SetNames(NamesInfo::CreateOptionalNames(resolved));
+}
+
 std::unique_ptr<Argument> ArgumentBuilder::Build() {
   ARGPARSE_DCHECK(arg_);
-  arg_->SetMetaVar(meta_var_ ? std::move(*meta_var_)
-                             : arg_->GetNames()->GetDefaultMetaVar());
+  arg_->SetMetaVar(has_meta_var_ ? meta_var_
+                                 : arg_->GetNames()->GetDefaultMetaVar());
 
   // Put a bool if needed.
   if (ActionNeedsBool(action_kind_)) {
@@ -52,6 +58,45 @@ std::unique_ptr<Argument> ArgumentBuilder::Build() {
   // Important phrase..
   auto* dest = arg_->GetDest();
 
+  // A custom action gets each value as it is, so nothing would split it.
+  ARGPARSE_CHECK_F(!delimiter_ || !arg_->GetAction(),
+                   "A delimiter doesn't work with a custom action");
+
+  // A tuple or a fixed-capacity array dest takes one value per element by
+  // default, unless a type like Hex() parses it as a whole.
+  if (!arg_->GetAction() && !arg_->GetType() &&
+      action_kind_ == ActionKind::kNoAction && dest &&
+      dest->GetOperations()->IsSupported(OpsKind::kStoreElements)) {
+    auto size = dest->GetOperations()->GetFixedSize(dest->GetDestPtr());
+    ARGPARSE_CHECK_F(size > 0, "The dest must have at least one element");
+    if (!arg_->GetNumArgs())
+      arg_->SetNumArgs(NumArgsInfo::CreateNumber(static_cast<int>(size)));
+    ARGPARSE_CHECK_F(arg_->GetNumArgs()->GetCount() == size,
+                     "The nargs of the dest must be its size %zu", size);
+    arg_->SetAction(
+        ActionInfo::CreateElementsAction(dest, delimiter_ ? delimiter_ : ','));
+  }
+
+  // A map dest takes "key=value" by default.
+  if (!arg_->GetAction() && action_kind_ == ActionKind::kNoAction && dest &&
+      dest->GetOperations()->IsSupported(OpsKind::kInsert)) {
+    arg_->SetAction(
+        ActionInfo::CreateInsertAction(dest, delimiter_, duplicate_key_));
+  }
+
+  if (delimiter_ && !arg_->GetAction()) {
+    ARGPARSE_CHECK_F(action_kind_ == ActionKind::kNoAction ||
+                         action_kind_ == ActionKind::kAppend,
+                     "A delimiter only works with the append action");
+    action_kind_ = ActionKind::kAppend;
+  }
+
+  // The values of nargs '*', '+' or N > 1 are appended to dest by default.
+  auto* num_args = arg_->GetNumArgs();
+  if ((arg_->TakesMany() || (num_args && num_args->GetCount() > 1)) &&
+      action_kind_ == ActionKind::kNoAction && dest && !arg_->GetAction())
+    action_kind_ = ActionKind::kAppend;
+
   if (!arg_->GetAction()) {
     // We assume a default store action but only if has dest.
     if (action_kind_ == ActionKind::kNoAction && dest) {
@@ -59,8 +104,10 @@ std::unique_ptr<Argument> ArgumentBuilder::Build() {
     }
     // Some action don't need an ops, like print_help, we perhaps need to
     // distinct that..
-    arg_->SetAction(ActionInfo::CreateBuiltinAction(action_kind_, dest,
-                                                    arg_->GetConstValue()));
+    arg_->SetAction(
+        delimiter_ ? ActionInfo::CreateSplitAppendAction(dest, delimiter_)
+                   : ActionInfo::CreateBuiltinAction(action_kind_, dest,
+                                                     arg_->GetConstValue()));
   }
 
   if (!arg_->GetType()) {
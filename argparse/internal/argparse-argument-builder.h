@@ -27,6 +27,14 @@ class ArgumentBuilder final {
     if (info) arg_->SetNames(std::move(info));
   }
 
+  // A name that can be positional or optional.
+  void SetSingleName(SpecString name) {
+    SetNames(NamesInfo::CreateSingleName(ResolveString(name)));
+  }
+
+  // A list of optional names.
+  void SetOptionalNames(absl::Span<const SpecString> names);
+
   void SetDest(std::unique_ptr<DestInfo> info) {
     if (info) arg_->SetDest(std::move(info));
   }
@@ -45,25 +53,30 @@ class ArgumentBuilder final {
 
   void SetTypeFileType(absl::string_view mode) { open_mode_ = mode; }
 
+  void SetDelimiter(char delimiter) { delimiter_ = delimiter; }
+
+  void SetDuplicateKey(DuplicateKey policy) { duplicate_key_ = policy; }
+
   void SetNumArgs(std::unique_ptr<NumArgsInfo> info) {
     if (info) arg_->SetNumArgs(std::move(info));
   }
 
-  void SetConstValue(std::unique_ptr<Any> val) {
+  void SetConstValue(Any val) {
     arg_->SetConstValue(std::move(val));
   }
 
-  void SetDefaultValue(std::unique_ptr<Any> val) {
+  void SetDefaultValue(Any val) {
     arg_->SetDefaultValue(std::move(val));
   }
 
-  void SetMetaVar(absl::string_view val) {
-    meta_var_ = absl::make_unique<std::string>(val);
+  void SetMetaVar(SpecString val) {
+    meta_var_ = ResolveString(val);
+    has_meta_var_ = true;
   }
 
   void SetRequired(bool val) { arg_->SetRequired(val); }
 
-  void SetHelp(absl::string_view val) { arg_->SetHelpDoc(val); }
+  void SetHelp(SpecString val) { arg_->SetHelpDoc(ResolveString(val)); }
 
   std::unique_ptr<Argument> Build();
 
@@ -72,12 +85,23 @@ class ArgumentBuilder final {
  private:
   ActionKind StringToActions(absl::string_view str);
 
+  // Literals are used as is, the other strings are kept by the argument until
+  // it is registered.
+  absl::string_view ResolveString(SpecString str) {
+    return str.is_literal() ? str.str() : str.Resolve(arg_->GetLocalStrings());
+  }
+
   // Some options are directly fed into arg.
   std::unique_ptr<Argument> arg_;
   // If not given, use default from NamesInfo.
-  std::unique_ptr<std::string> meta_var_;
+  absl::string_view meta_var_;
+  bool has_meta_var_ = false;
   ActionKind action_kind_ = ActionKind::kNoAction;
   absl::string_view open_mode_;
+  // If not '\0', a value is split on it and each piece is appended (or
+  // inserted into a map).
+  char delimiter_ = '\0';
+  DuplicateKey duplicate_key_ = DuplicateKey::kOverwrite;
 };
 
 }  // namespace internal
@@ -3,7 +3,15 @@
 namespace argparse {
 namespace internal {
 
-ArgumentContainer::ArgumentContainer() {}
+ArgumentContainer::ArgumentContainer() : main_holder_(&strings_) {}
+
+void ArgumentContainer::AddMemoryUsage(MemoryReport* report) const {
+  report->groups.AddObject(*this);
+  main_holder_.AddMemoryUsage(report);
+  strings_.AddMemoryUsage(&report->strings);
+  // SubCommands are not held by the container yet, so per_subcommand stays
+  // empty. See SubCommand::AddMemoryUsage().
+}
 
 }  // namespace internal
 }  // namespace argparse
@@ -23,8 +23,16 @@ class ArgumentContainer final {
  public:
   ArgumentContainer();
   ArgumentHolder* GetMainHolder() { return &main_holder_; }
+  // The pool where the strings of all the arguments are interned.
+  StringPool* GetStrings() { return &strings_; }
+
+  // Add the memory of everything held by the container to `report`. The
+  // container itself is counted as a group.
+  void AddMemoryUsage(MemoryReport* report) const;
 
  private:
+  // Declared first, since holders refer to it.
+  StringPool strings_;
   ArgumentHolder main_holder_;
 };
 
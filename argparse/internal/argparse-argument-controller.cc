@@ -5,6 +5,12 @@
 
 #include "argparse/internal/argparse-argument-controller.h"
 
+#include <cstdio>
+#include <cstdlib>
+
+#include "absl/debugging/leak_check.h"
+#include "absl/strings/str_cat.h"
+
 #ifndef NDEBUG
 #define ARGPARSE_ARGUMENT_CONTROLLER_CHECK_STATE(expected_state)               \
   do {                                                                         \
@@ -49,15 +55,57 @@ ArgumentGroup* ArgumentController::AddArgumentGroup(absl::string_view title) {
   return container_->GetMainHolder()->AddArgumentGroup(title);
 }
 
-bool ArgumentController::ParseKnownArgs(ArgArray args,
-                                        std::vector<std::string>* out) {
+void ArgumentController::Reserve(std::size_t args, std::size_t groups,
+                                 std::size_t names) {
+  ARGPARSE_ARGUMENT_CONTROLLER_CHECK_STATE(kActiveState);
+  container_->GetMainHolder()->Reserve(args, groups, names);
+}
+
+absl::Status ArgumentController::ParseKnownArgs(
+    ArgArray args, std::vector<int>* unknown) {
   EnsureInFrozenState();
-  return parser_->ParseKnownArgs(args, out);
+  ParseBudgetTracker budget(budget_);
+  // Refuse an oversized command line before the backend sees it.
+  auto status = budget.ChargeArgs(args);
+  if (status.ok()) status = CheckStorage(args);
+  if (status.ok()) status = parser_->ParseKnownArgs(args, &budget, unknown);
+  if (!status.ok() && !unknown) {
+    // Like argparse, report the error and exit.
+    std::fprintf(stderr, "%s\n", std::string(status.message()).c_str());
+    std::exit(2);
+  }
+  return status;
+}
+
+MemoryReport ArgumentController::GetMemoryReport() const {
+  ARGPARSE_INTERNAL_DCHECK(state_ != kShutDownState,
+                           "GetMemoryReport() called after shutdown");
+  MemoryReport report;
+  container_->AddMemoryUsage(&report);
+  parser_->AddMemoryUsage(&report.backend);
+  return report;
+}
+
+absl::Status ArgumentController::CheckStorage(ArgArray args) const {
+  if (args.GetStorage() == ArgStorage::kPersistent) return absl::OkStatus();
+  auto* arg = container_->GetMainHolder()->GetFirstArgumentBoundToInput();
+  if (!arg) return absl::OkStatus();
+  return absl::FailedPreconditionError(
+      absl::StrCat("argument ", arg->GetNames()->GetName(0),
+                   " refers to the command line, which does not outlive "
+                   "the parse"));
 }
 
 void ArgumentController::Shutdown() {
   if (state_ == kShutDownState) return;
   state_ = kShutDownState;
+  if (fast_teardown_) {
+    // The process is exiting, let it reclaim the memory. This also skips the
+    // cleanup of the backend, e.g., gflags::ShutDownCommandLineFlags().
+    absl::IgnoreLeak(container_.release());
+    absl::IgnoreLeak(parser_.release());
+    return;
+  }
   // Must delete container first.
   container_.reset();
   parser_.reset();
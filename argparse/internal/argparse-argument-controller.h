@@ -17,12 +17,16 @@ namespace internal {
 class ArgumentController final {
  public:
   ArgumentController();
+  ~ArgumentController() { Shutdown(); }
 
   // Methods forwarded from ArgumentContainer.
   void AddArgument(std::unique_ptr<Argument> arg);
 
   ArgumentGroup* AddArgumentGroup(absl::string_view title);
 
+  // See ArgumentHolder::Reserve().
+  void Reserve(std::size_t args, std::size_t groups, std::size_t names);
+
   SubCommandGroup* AddSubCommandGroup(std::unique_ptr<SubCommandGroup> group) {
     return nullptr;
   }
@@ -32,12 +36,27 @@ class ArgumentController final {
   void SetOption(ParserOptions key, absl::string_view value);
 
   // TODO: make API more clear.
-  bool ParseKnownArgs(ArgArray args, std::vector<std::string>* out);
+  // Fail with ResourceExhausted if the parse goes beyond the budget.
+  // The indices of the unknown tokens are appended to `unknown`. If it is
+  // null, the program exits on error.
+  absl::Status ParseKnownArgs(ArgArray args, std::vector<int>* unknown);
+
+  // Limit the resources of each parse call. Unlimited by default.
+  void SetParseBudget(const ParseBudget& budget) { budget_ = budget; }
+
+  // Report the memory used by the arguments and the backend.
+  MemoryReport GetMemoryReport() const;
 
   // Clean all the memory of this object, after that no methods other than dtor
   // should be invoked.
   void Shutdown();
 
+  // If enabled, Shutdown() leaks the arguments and the backend instead of
+  // destroying them one by one, so releasing the parser is O(1). Only for a
+  // parser that lives until the process exits. The dests are owned by the user
+  // and are destroyed as usual.
+  void SetFastTeardown(bool enable) { fast_teardown_ = enable; }
+
  private:
   enum State {
     kActiveState,    // In this state, arguments can be added to us.
@@ -49,7 +68,12 @@ class ArgumentController final {
 
   void EnsureInFrozenState();
 
+  // Refuse transient `args` if an argument would point into them.
+  absl::Status CheckStorage(ArgArray args) const;
+
   State state_ = kActiveState;
+  bool fast_teardown_ = false;
+  ParseBudget budget_;
   std::unique_ptr<ArgumentContainer> container_;
   std::unique_ptr<ArgumentParser> parser_;
 };
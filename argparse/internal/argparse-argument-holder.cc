@@ -5,6 +5,8 @@
 
 #include "argparse/internal/argparse-argument-holder.h"
 
+#include <algorithm>
+
 #include "argparse/internal/argparse-argument.h"
 
 namespace argparse {
@@ -25,7 +27,18 @@ void ArgumentGroup::SetTitle(absl::string_view title) {
   }
 }
 
-ArgumentHolder::ArgumentHolder() {
+void ArgumentGroup::AddMemoryUsage(MemoryReport* report) const {
+  report->groups.AddObject(*this);
+  report->groups.AddBuffer(title_);
+  report->groups.AddBuffer(arguments_);
+  for (const auto& arg : arguments_) arg->AddMemoryUsage(report);
+}
+
+ArgumentHolder::ArgumentHolder(StringPool* strings) : strings_(strings) {
+  if (!strings_) {
+    own_strings_ = absl::make_unique<StringPool>();
+    strings_ = own_strings_.get();
+  }
   constexpr absl::string_view kDefaultGroupTitles[] = {
       "positional arguments:",
       "optional arguments:",
@@ -43,6 +56,27 @@ ArgumentGroup* ArgumentHolder::AddArgumentGroup(absl::string_view title) {
   return group_ptr;
 }
 
+void ArgumentHolder::Reserve(std::size_t args, std::size_t groups,
+                             std::size_t names) {
+  names = std::max(names, args);
+  groups_.reserve(groups_.size() + groups);
+  GetDefaultGroup(ArgumentGroup::kOptionalGroupIndex)->Reserve(args);
+  name_set_.reserve(name_set_.size() + names);
+  strings_->Reserve(names);
+}
+
+void ArgumentHolder::AddMemoryUsage(MemoryReport* report) const {
+  for (const auto& group : groups_) {
+    auto before = report->GetTotal();
+    group->AddMemoryUsage(report);
+    report->per_group.push_back(
+        {std::string(group->GetTitle()), report->GetTotal() - before});
+  }
+  report->groups.AddBuffer(groups_);
+  report->groups.AddHashTable(name_set_);
+  if (own_strings_) own_strings_->AddMemoryUsage(&report->strings);
+}
+
 void ArgumentHolder::AddArgument(std::unique_ptr<Argument> arg) {
   ARGPARSE_DCHECK(arg);
   // True == isOption() == OptionalGroupIndex == 1
@@ -51,7 +85,10 @@ void ArgumentHolder::AddArgument(std::unique_ptr<Argument> arg) {
 }
 
 void ArgumentHolder::OnAddArgument(Argument* arg, ArgumentGroup* group) {
+  // Names must be interned before they go into name_set_.
+  arg->InternStrings(strings_);
   CheckNamesConflict(arg);
+  if (!bound_to_input_ && arg->IsBoundToInput()) bound_to_input_ = arg;
   ++total_argument_count_;
 }
 
@@ -42,6 +42,11 @@ class ArgumentGroup final : public SupportUserData {
   // Add an arg to this group.
   void AddArgument(std::unique_ptr<Argument> arg);
 
+  // Make room for `count` more arguments.
+  void Reserve(std::size_t count) {
+    arguments_.reserve(arguments_.size() + count);
+  }
+
   // Allow fast iteration over all arguments:
   // for (auto i = 0; i < g->GetArgumentCount(); ++i)
   //    g->GetArgument(i);
@@ -49,6 +54,10 @@ class ArgumentGroup final : public SupportUserData {
 
   Argument* GetArgument(std::size_t i) const { return arguments_[i].get(); }
 
+  // Count this group in `groups` of `report` and its arguments as in
+  // Argument::AddMemoryUsage().
+  void AddMemoryUsage(MemoryReport* report) const;
+
   // ArgumentGroup is allocated on the heap for pointer stability.
   static std::unique_ptr<ArgumentGroup> Create(Delegate* delegate) {
     return absl::WrapUnique(new ArgumentGroup(delegate));
@@ -65,7 +74,9 @@ class ArgumentHolder final : private ArgumentGroup::Delegate {
  public:
   // Allocated directly.
   // Two default groups will be created.
-  ArgumentHolder();
+  // The strings of the arguments are interned into `strings`, which is
+  // usually shared by the whole container. If null, the holder uses its own.
+  explicit ArgumentHolder(StringPool* strings = nullptr);
 
   // Allow fast iteration over all ArgumentGroups.
   std::size_t GetArgumentGroupCount() const { return groups_.size(); }
@@ -85,9 +96,26 @@ class ArgumentHolder final : private ArgumentGroup::Delegate {
   // method to add arg to default group (inferred from arg).
   void AddArgument(std::unique_ptr<Argument> arg);
 
+  // A hint of how many more arguments, groups and names are going to be added,
+  // so that a large spec is registered without rehashing or reallocation.
+  // Arguments are assumed to go to the default optional group. If `names` is
+  // smaller than `args`, `args` is used.
+  void Reserve(std::size_t args, std::size_t groups, std::size_t names);
+
   // Return the total number of arguments in all groups.
   std::size_t GetTotalArgumentCount() const { return total_argument_count_; }
 
+  StringPool* GetStrings() const { return strings_; }
+
+  // Return the first argument that is bound to the command line (see
+  // Argument::IsBoundToInput()), or null.
+  Argument* GetFirstArgumentBoundToInput() const { return bound_to_input_; }
+
+  // Add the memory of all the groups and arguments to `report`, with an entry
+  // in `per_group` for each group. The holder itself is not counted since it
+  // is a member of its owner.
+  void AddMemoryUsage(MemoryReport* report) const;
+
  private:
   // All the names of the arguments from all groups, including optional and
   // positional ones should not be duplicated. The namespace is not per
@@ -100,9 +128,13 @@ class ArgumentHolder final : private ArgumentGroup::Delegate {
 
   // Argument count sumed accross all groups.
   unsigned total_argument_count_ = 0;
+  Argument* bound_to_input_ = nullptr;
+  // Set if no StringPool is given to us.
+  std::unique_ptr<StringPool> own_strings_;
+  StringPool* strings_;
   // In many cases, there are just default groups, so make the capacity 2.
   absl::InlinedVector<std::unique_ptr<ArgumentGroup>, 2> groups_;
-  // The strings are kept alive by NamesInfo.
+  // The strings are kept alive by strings_.
   absl::flat_hash_set<absl::string_view> name_set_;
 };
 
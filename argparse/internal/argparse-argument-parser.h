@@ -7,8 +7,11 @@
 
 #include <memory>
 
+#include "absl/status/status.h"
 #include "absl/strings/string_view.h"
 #include "argparse/internal/argparse-arg-array.h"
+#include "argparse/internal/argparse-memory-usage.h"
+#include "argparse/internal/argparse-parse-budget.h"
 
 namespace argparse {
 namespace internal {
@@ -39,9 +42,15 @@ class ArgumentParser {
   // Read the content of the ArgumentContainer and prepare for parsing.
   // The container is guaranteed to have longer lifetime than the parser.
   virtual void Initialize(ArgumentContainer* container) = 0;
-  // Parse args, if rest is null, exit on error. Otherwise put unknown ones into
-  // rest and return status code.
-  virtual bool ParseKnownArgs(ArgArray args, std::vector<std::string>* out) = 0;
+  // Parse args, if `unknown` is null, exit on error. Otherwise append the
+  // indices (into `args`) of the unknown tokens to `unknown` and return the
+  // status. The tokens are already charged to `budget`, the values appended to
+  // dests must be charged through Argument::Run().
+  virtual absl::Status ParseKnownArgs(ArgArray args,
+                                      ParseBudgetTracker* budget,
+                                      std::vector<int>* unknown) = 0;
+  // Count the memory of the backend, including the parser object.
+  virtual void AddMemoryUsage(MemoryUsage* usage) const = 0;
   static std::unique_ptr<ArgumentParser> CreateDefault();
 };
 
@@ -5,9 +5,25 @@
 
 #include "argparse/internal/argparse-argument.h"
 
+#include "absl/strings/str_cat.h"
+
 namespace argparse {
 namespace internal {
 
+namespace {
+
+// Don't echo more than this of a bad value, the command line may be hostile.
+constexpr std::size_t kMaxValueInError = 64;
+
+std::string FormatValueError(absl::string_view name, absl::string_view value,
+                             absl::string_view errmsg) {
+  auto shown = value.substr(0, kMaxValueInError);
+  return absl::StrCat("argument ", name, ": ", errmsg, ": '", shown,
+                      shown.size() < value.size() ? "...'" : "'");
+}
+
+}  // namespace
+
 std::unique_ptr<Argument> Argument::Create() {
   return absl::make_unique<Argument>();
 }
@@ -29,6 +45,84 @@ bool Argument::AppendDefaultValueAsString(std::string* out) {
   return false;
 }
 
+absl::Status Argument::Run(absl::optional<absl::string_view> value,
+                           ParseBudgetTracker* budget) {
+  if (value && type_info_ && action_info_ && action_info_->RunsInPlace()) {
+    // The value is used on the spot, so it is never put into an Any.
+    if (action_info_->AppendsToDest()) {
+      auto status = ChargeAppend(value, budget);
+      if (!status.ok()) return status;
+    }
+    std::string errmsg;
+    if (action_info_->RunInPlace(type_info_.get(), *value, &errmsg))
+      return absl::OkStatus();
+    return ValueError(*value, errmsg, budget);
+  }
+  Any data;
+  if (value) {
+    OpsResult result;
+    if (type_info_ && type_info_->GetOps()) type_info_->Run(*value, &result);
+    if (result.has_error) return ValueError(*value, result.errmsg, budget);
+    data = std::move(result.value);
+  }
+  if (action_info_ && action_info_->AppendsToDest()) {
+    auto status = ChargeAppend(value, budget);
+    if (!status.ok()) return status;
+  }
+  if (action_info_) action_info_->Run(std::move(data));
+  return absl::OkStatus();
+}
+
+absl::Status Argument::RunMany(absl::Span<const absl::string_view> values,
+                               ParseBudgetTracker* budget) {
+  std::string errmsg;
+  if (num_args_ && !num_args_->Run(values.size(), &errmsg))
+    return ArgumentError(errmsg, budget);
+  if (!type_info_ || !action_info_ || !action_info_->RunsManyInPlace()) {
+    for (auto value : values) {
+      auto status = Run(value, budget);
+      if (!status.ok()) return status;
+    }
+    return absl::OkStatus();
+  }
+  // Charge for all the values before the dest grows for them.
+  std::size_t bytes = values.size() * type_info_->GetOps()->GetTypeSize();
+  for (auto value : values) bytes += value.size();
+  auto status = budget->ChargeValues(values.size(), bytes);
+  if (!status.ok()) return status;
+  std::size_t bad_index = 0;
+  if (action_info_->RunManyInPlace(type_info_.get(), values,
+                                   budget->GetMaxThreads(), &bad_index,
+                                   &errmsg))
+    return absl::OkStatus();
+  return ValueError(values[bad_index], errmsg, budget);
+}
+
+absl::Status Argument::ChargeAppend(absl::optional<absl::string_view> value,
+                                    ParseBudgetTracker* budget) {
+  auto* ops = type_info_ ? type_info_->GetOps() : nullptr;
+  std::size_t count = value ? action_info_->GetValueCount(*value) : 1;
+  auto bytes = count * (ops ? ops->GetTypeSize() : 0) +
+               (value ? value->size() : 0);
+  return budget->ChargeValues(count, bytes);
+}
+
+absl::Status Argument::ArgumentError(absl::string_view errmsg,
+                                     ParseBudgetTracker* budget) {
+  auto message =
+      absl::StrCat("argument ", GetNames()->GetName(0), ": ", errmsg);
+  auto status = budget->ChargeBytes(message.size());
+  return status.ok() ? absl::InvalidArgumentError(message) : status;
+}
+
+absl::Status Argument::ValueError(absl::string_view value,
+                                  absl::string_view errmsg,
+                                  ParseBudgetTracker* budget) {
+  auto message = FormatValueError(GetNames()->GetName(0), value, errmsg);
+  auto status = budget->ChargeBytes(message.size());
+  return status.ok() ? absl::InvalidArgumentError(message) : status;
+}
+
 bool Argument::BeforeInUsage(Argument* a, Argument* b) {
   // options go before positionals.
   if (a->IsOptional() != b->IsOptional()) return a->IsOptional();
@@ -48,5 +142,28 @@ bool Argument::BeforeInUsage(Argument* a, Argument* b) {
   return a->GetName() < b->GetName();
 }
 
+void Argument::InternStrings(StringPool* pool) {
+  if (!local_strings_) return;  // Only literals.
+  auto intern = [this, pool](absl::string_view* str) {
+    if (local_strings_->Owns(*str)) *str = pool->Intern(*str);
+  };
+  intern(&help_doc_);
+  intern(&meta_var_);
+  if (names_info_) names_info_->InternNames(*local_strings_, pool);
+  local_strings_.reset();
+}
+
+void Argument::AddMemoryUsage(MemoryReport* report) const {
+  report->arguments.AddObject(*this);
+  if (dest_info_) dest_info_->AddMemoryUsage(&report->arguments);
+  if (action_info_) action_info_->AddMemoryUsage(&report->arguments);
+  if (type_info_) type_info_->AddMemoryUsage(&report->arguments);
+  if (num_args_) num_args_->AddMemoryUsage(&report->arguments);
+  if (names_info_) names_info_->AddMemoryUsage(&report->names);
+  report->values.AddAllocation(const_value_.GetHeapSize());
+  report->values.AddAllocation(default_value_.GetHeapSize());
+  if (local_strings_) local_strings_->AddMemoryUsage(&report->strings);
+}
+
 }  // namespace internal
 }  // namespace argparse
@@ -5,7 +5,10 @@
 
 #pragma once
 
+#include "absl/status/status.h"
+#include "absl/types/optional.h"
 #include "argparse/internal/argparse-info.h"
+#include "argparse/internal/argparse-parse-budget.h"
 
 namespace argparse {
 namespace internal {
@@ -23,8 +26,13 @@ class Argument final : public SupportUserData {
   NumArgsInfo* GetNumArgs() const { return num_args_.get(); }
   NamesInfo* GetNames() const { return names_info_.get(); }
 
-  const Any* GetConstValue() const { return const_value_.get(); }
-  const Any* GetDefaultValue() const { return default_value_.get(); }
+  // Return null if not set.
+  const Any* GetConstValue() const {
+    return const_value_ ? &const_value_ : nullptr;
+  }
+  const Any* GetDefaultValue() const {
+    return default_value_ ? &default_value_ : nullptr;
+  }
 
   absl::string_view GetMetaVar() const { return meta_var_; }
   absl::string_view GetHelpDoc() const { return help_doc_; }
@@ -48,9 +56,39 @@ class Argument final : public SupportUserData {
   // Append the string form of the default value.
   bool AppendDefaultValueAsString(std::string* out);
 
+  // Convert `value` (if any) by the type and pass the result to the action.
+  // The values appended to the dest and the error message are charged to
+  // `budget`.
+  absl::Status Run(absl::optional<absl::string_view> value,
+                   ParseBudgetTracker* budget);
+
+  // Run on all the values given to an argument that TakesMany(). The count
+  // is checked against nargs, and an append action converts them in one go.
+  // An error names the bad value.
+  absl::Status RunMany(absl::Span<const absl::string_view> values,
+                       ParseBudgetTracker* budget);
+
+  // Whether nargs is '*' or '+'.
+  bool TakesMany() const { return num_args_ && num_args_->TakesMany(); }
+
+  // Whether the values of this argument refer to the command line, which then
+  // must outlive the dest.
+  bool IsBoundToInput() const {
+    return type_info_ && type_info_->GetOps() &&
+           type_info_->GetOps()->IsViewType();
+  }
+
   // Return true if `lhs` should appear before `rhs` in a usage message.
   static bool BeforeInUsage(Argument* lhs, Argument* rhs);
 
+  // Move the strings this argument owns into `pool`, which is shared by all
+  // the arguments of a container. Called when the argument is registered.
+  void InternStrings(StringPool* pool);
+
+  // Add the memory of this argument to the `arguments`, `names`, `values`
+  // and `strings` of `report`.
+  void AddMemoryUsage(MemoryReport* report) const;
+
   static std::unique_ptr<Argument> Create();
 
  private:
@@ -58,12 +96,9 @@ class Argument final : public SupportUserData {
     names_info_ = std::move(info);
   }
   void SetRequired(bool required) { is_required_ = required; }
-  void SetHelpDoc(absl::string_view value) {
-    help_doc_ = static_cast<std::string>(value);
-  }
-  void SetMetaVar(absl::string_view value) {
-    meta_var_ = static_cast<std::string>(value);
-  }
+  // The strings must outlive the argument. See GetLocalStrings().
+  void SetHelpDoc(absl::string_view value) { help_doc_ = value; }
+  void SetMetaVar(absl::string_view value) { meta_var_ = value; }
   void SetDest(std::unique_ptr<DestInfo> info) {
     if (info) dest_info_ = std::move(info);
   }
@@ -73,10 +108,10 @@ class Argument final : public SupportUserData {
   void SetAction(std::unique_ptr<ActionInfo> info) {
     if (info) action_info_ = std::move(info);
   }
-  void SetConstValue(std::unique_ptr<Any> value) {
+  void SetConstValue(Any value) {
     if (value) const_value_ = std::move(value);
   }
-  void SetDefaultValue(std::unique_ptr<Any> value) {
+  void SetDefaultValue(Any value) {
     if (value) default_value_ = std::move(value);
   }
   void SetGroup(ArgumentGroup* group) {
@@ -87,20 +122,40 @@ class Argument final : public SupportUserData {
     if (info) num_args_ = std::move(info);
   }
 
+  // Storage of the non-literal strings before the argument is registered.
+  StringPool* GetLocalStrings() {
+    if (!local_strings_) local_strings_ = absl::make_unique<StringPool>();
+    return local_strings_.get();
+  }
+
+  // Charge `budget` for what the action appends for `value`.
+  absl::Status ChargeAppend(absl::optional<absl::string_view> value,
+                            ParseBudgetTracker* budget);
+
+  // The error of this argument, charged to `budget`.
+  absl::Status ArgumentError(absl::string_view errmsg,
+                             ParseBudgetTracker* budget);
+
+  // The error of an invalid `value`, charged to `budget`.
+  absl::Status ValueError(absl::string_view value, absl::string_view errmsg,
+                          ParseBudgetTracker* budget);
+
   // Only ArgumentBuilder can access the setters.
   friend class ArgumentBuilder;
 
   ArgumentGroup* group_ = nullptr;
-  std::string help_doc_;
-  std::string meta_var_;
+  absl::string_view help_doc_;
+  absl::string_view meta_var_;
+  // Null once the strings are interned into the container.
+  std::unique_ptr<StringPool> local_strings_;
   bool is_required_ = false;
   std::unique_ptr<NamesInfo> names_info_;
   std::unique_ptr<DestInfo> dest_info_;
   std::unique_ptr<ActionInfo> action_info_;
   std::unique_ptr<TypeInfo> type_info_;
   std::unique_ptr<NumArgsInfo> num_args_;
-  std::unique_ptr<Any> const_value_;
-  std::unique_ptr<Any> default_value_;
+  Any const_value_;
+  Any default_value_;
 };
 
 }  // namespace internal
@@ -14,9 +14,12 @@ namespace default_parser_internal {
 class DefaultParser final : public ArgumentParser {
  public:
   void Initialize(ArgumentContainer* container) override {}
-  bool ParseKnownArgs(ArgArray args,
-                      std::vector<std::string>* unparsed_args) override {
-    return false;
+  absl::Status ParseKnownArgs(ArgArray args, ParseBudgetTracker* budget,
+                              std::vector<int>* unknown) override {
+    return absl::UnimplementedError("no parser backend");
+  }
+  void AddMemoryUsage(MemoryUsage* usage) const override {
+    usage->AddObject(*this);
   }
 };
 
@@ -0,0 +1,147 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "argparse/internal/argparse-encoding.h"
+
+#include <cstring>
+
+namespace argparse {
+namespace internal {
+namespace encoding_internal {
+namespace {
+
+constexpr std::uint64_t kOnes = 0x0101010101010101;
+constexpr std::uint64_t kHigh = 0x8080808080808080;
+
+// Compilers turn this into a single load on little-endian machines.
+std::uint64_t LoadLittleEndian64(const char* p) {
+  std::uint64_t value = 0;
+  for (int i = 7; i >= 0; --i)
+    value = (value << 8) | static_cast<unsigned char>(p[i]);
+  return value;
+}
+
+// The high bit of each byte of `x` (below 0x80) is set iff the byte is in
+// (m, n). There is no carry between the bytes.
+constexpr std::uint64_t Between(std::uint64_t x, unsigned m, unsigned n) {
+  return (kOnes * (127 + n) - (x & kOnes * 127)) & ~x &
+         ((x & kOnes * 127) + kOnes * (127 - m)) & kHigh;
+}
+
+// Decode 8 hex digits, the first one in the lowest byte of `chunk`, into 4
+// bytes. Fail if any of them is not a hex digit.
+bool DecodeHexChunk(std::uint64_t chunk, std::uint8_t* out) {
+  auto digits = Between(chunk, '0' - 1, '9' + 1) |
+                Between(chunk, 'A' - 1, 'F' + 1) |
+                Between(chunk, 'a' - 1, 'f' + 1);
+  if (digits != kHigh) return false;
+  // Letters have 0x40 set, and their low nibble is 1 to 6 for a to f.
+  auto letters = (chunk >> 6) & kOnes;
+  auto nibbles = (chunk & (kOnes * 0x0F)) + letters * 9;
+  // Each pair of nibbles into a byte, in a 16-bit lane.
+  constexpr std::uint64_t kLow = 0x000F000F000F000F;
+  auto pairs = ((nibbles & kLow) << 4) | ((nibbles >> 8) & kLow);
+  // Then the 4 bytes together.
+  pairs = (pairs | (pairs >> 8)) & 0x0000FFFF0000FFFF;
+  pairs = pairs | (pairs >> 16);
+  for (int i = 0; i < 4; ++i)
+    out[i] = static_cast<std::uint8_t>(pairs >> (8 * i));
+  return true;
+}
+
+int HexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+// The 6-bit value of each base64 char, or 0xFF.
+struct Base64Table {
+  std::uint8_t values[256];
+  Base64Table() {
+    static const char kAlphabet[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::memset(values, 0xFF, sizeof(values));
+    for (int i = 0; i < 64; ++i)
+      values[static_cast<unsigned char>(kAlphabet[i])] =
+          static_cast<std::uint8_t>(i);
+  }
+};
+
+const Base64Table& GetBase64Table() {
+  static const Base64Table kTable;
+  return kTable;
+}
+
+}  // namespace
+
+bool GetHexDecodedSize(absl::string_view in, std::size_t* size) {
+  if (in.size() % 2) return false;
+  *size = in.size() / 2;
+  return true;
+}
+
+bool DecodeHex(absl::string_view in, std::uint8_t* out) {
+  const char* p = in.data();
+  const char* end = p + in.size();
+  for (; end - p >= 8; p += 8, out += 4) {
+    if (!DecodeHexChunk(LoadLittleEndian64(p), out)) return false;
+  }
+  for (; p != end; p += 2) {
+    int high = HexValue(p[0]), low = HexValue(p[1]);
+    if (high < 0 || low < 0) return false;
+    *out++ = static_cast<std::uint8_t>(high << 4 | low);
+  }
+  return true;
+}
+
+bool GetBase64DecodedSize(absl::string_view in, std::size_t* size) {
+  if (in.size() % 4) return false;
+  std::size_t padding = 0;
+  while (padding < 2 && padding < in.size() &&
+         in[in.size() - 1 - padding] == '=')
+    ++padding;
+  *size = in.size() / 4 * 3 - padding;
+  return true;
+}
+
+bool DecodeBase64(absl::string_view in, std::uint8_t* out) {
+  if (in.empty()) return true;
+  const auto& table = GetBase64Table().values;
+  const auto* p = reinterpret_cast<const unsigned char*>(in.data());
+  // The last group may have padding, the others are done 4 chars at a time:
+  // any 0xFF among the values sets a bit above the 24 that are used.
+  const auto* last = p + in.size() - 4;
+  for (; p != last; p += 4, out += 3) {
+    std::uint32_t bits = std::uint32_t{table[p[0]]} << 18 |
+                         std::uint32_t{table[p[1]]} << 12 |
+                         std::uint32_t{table[p[2]]} << 6 | table[p[3]];
+    if ((table[p[0]] | table[p[1]] | table[p[2]] | table[p[3]]) & 0xC0)
+      return false;
+    out[0] = static_cast<std::uint8_t>(bits >> 16);
+    out[1] = static_cast<std::uint8_t>(bits >> 8);
+    out[2] = static_cast<std::uint8_t>(bits);
+  }
+
+  int padding = (p[3] == '=') + (p[2] == '=' && p[3] == '=');
+  std::uint32_t bits = 0;
+  for (int i = 0; i < 4 - padding; ++i) {
+    auto value = table[p[i]];
+    if (value == 0xFF) return false;
+    bits = bits << 6 | value;
+  }
+  bits <<= 6 * padding;
+  // The bits that the padding drops.
+  if (bits & ((1u << (8 * padding)) - 1)) return false;
+  out[0] = static_cast<std::uint8_t>(bits >> 16);
+  if (padding < 2) out[1] = static_cast<std::uint8_t>(bits >> 8);
+  if (padding < 1) out[2] = static_cast<std::uint8_t>(bits);
+  return true;
+}
+
+}  // namespace encoding_internal
+}  // namespace internal
+}  // namespace argparse
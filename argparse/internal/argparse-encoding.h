@@ -0,0 +1,76 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+
+// Binary values given as text: hex ("deadbeef") and base64 ("3q2+7w==").
+namespace argparse {
+namespace internal {
+namespace encoding_internal {
+
+// The number of bytes `in` decodes to. Fail if it has an odd length.
+bool GetHexDecodedSize(absl::string_view in, std::size_t* size);
+
+// Decode `in`, pairs of hex digits in either case, into `out`, which has
+// room for GetHexDecodedSize() bytes. Fail on any other char.
+bool DecodeHex(absl::string_view in, std::uint8_t* out);
+
+// The number of bytes `in` decodes to. Fail unless its length is a multiple
+// of 4 with at most two '=' of padding at the end.
+bool GetBase64DecodedSize(absl::string_view in, std::size_t* size);
+
+// Decode `in`, base64 of RFC 4648 with padding, into `out`, which has room
+// for GetBase64DecodedSize() bytes. Fail on a char out of the alphabet, or if
+// the bits dropped by the padding are not 0, so each value has one encoding.
+bool DecodeBase64(absl::string_view in, std::uint8_t* out);
+
+// Dests that hold a binary value.
+template <typename T>
+struct IsByteBuffer : std::false_type {};
+template <typename Alloc>
+struct IsByteBuffer<std::vector<std::uint8_t, Alloc>> : std::true_type {};
+template <std::size_t N>
+struct IsByteBuffer<std::array<std::uint8_t, N>> : std::true_type {};
+
+// Size `out` for `size` bytes. A std::array must have exactly that size.
+template <typename Alloc>
+bool ResizeBuffer(std::size_t size, std::vector<std::uint8_t, Alloc>* out) {
+  out->resize(size);
+  return true;
+}
+template <std::size_t N>
+bool ResizeBuffer(std::size_t size, std::array<std::uint8_t, N>*) {
+  return size == N;
+}
+
+// Decode right into the dest: no string is made on the way.
+template <typename T>
+bool DecodeHexTo(absl::string_view in, T* out) {
+  std::size_t size;
+  return GetHexDecodedSize(in, &size) && ResizeBuffer(size, out) &&
+         DecodeHex(in, out->data());
+}
+
+template <typename T>
+bool DecodeBase64To(absl::string_view in, T* out) {
+  std::size_t size;
+  return GetBase64DecodedSize(in, &size) && ResizeBuffer(size, out) &&
+         DecodeBase64(in, out->data());
+}
+
+}  // namespace encoding_internal
+
+using encoding_internal::IsByteBuffer;
+
+}  // namespace internal
+}  // namespace argparse
@@ -0,0 +1,99 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "argparse/internal/argparse-encoding.h"
+
+#include "gtest/gtest.h"
+
+namespace argparse {
+namespace internal {
+namespace testing_internal {
+
+using encoding_internal::DecodeBase64To;
+using encoding_internal::DecodeHexTo;
+using Bytes = std::vector<std::uint8_t>;
+
+TEST(Encoding, DecodeHex) {
+  Bytes bytes;
+  EXPECT_TRUE(DecodeHexTo("", &bytes));
+  EXPECT_TRUE(bytes.empty());
+  EXPECT_TRUE(DecodeHexTo("deadBEEF", &bytes));
+  EXPECT_EQ(bytes, (Bytes{0xde, 0xad, 0xbe, 0xef}));
+  // Past a chunk of 8 digits, and a tail.
+  EXPECT_TRUE(DecodeHexTo("00112233445566778899aAbBcCdDeEfF", &bytes));
+  EXPECT_EQ(bytes, (Bytes{0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+                          0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff}));
+  EXPECT_TRUE(DecodeHexTo("0123456789", &bytes));
+  EXPECT_EQ(bytes, (Bytes{0x01, 0x23, 0x45, 0x67, 0x89}));
+}
+
+TEST(Encoding, DecodeHexStrict) {
+  Bytes bytes;
+  EXPECT_FALSE(DecodeHexTo("abc", &bytes));
+  EXPECT_FALSE(DecodeHexTo("0xab", &bytes));
+  EXPECT_FALSE(DecodeHexTo("de ad", &bytes));
+  // Each char just outside the digits, in a chunk and in the tail.
+  for (char c : {'/', ':', '@', 'G', '`', 'g', '\x80', '\xc6', '\0'}) {
+    std::string chunk = "0123456789";
+    for (std::size_t i = 0; i < chunk.size(); ++i) {
+      auto bad = chunk;
+      bad[i] = c;
+      EXPECT_FALSE(DecodeHexTo(bad, &bytes)) << i << ' ' << int(c);
+    }
+  }
+}
+
+TEST(Encoding, DecodeHexIntoArray) {
+  std::array<std::uint8_t, 4> key{};
+  EXPECT_TRUE(DecodeHexTo("c0ffee00", &key));
+  EXPECT_EQ(key, (std::array<std::uint8_t, 4>{{0xc0, 0xff, 0xee, 0x00}}));
+  EXPECT_FALSE(DecodeHexTo("c0ffee", &key));
+  EXPECT_FALSE(DecodeHexTo("c0ffee0000", &key));
+}
+
+TEST(Encoding, DecodeBase64) {
+  Bytes bytes;
+  EXPECT_TRUE(DecodeBase64To("", &bytes));
+  EXPECT_TRUE(bytes.empty());
+  // RFC 4648, section 10.
+  const char* kCases[][2] = {
+      {"Zg==", "f"},       {"Zm8=", "fo"},      {"Zm9v", "foo"},
+      {"Zm9vYg==", "foob"}, {"Zm9vYmE=", "fooba"}, {"Zm9vYmFy", "foobar"},
+  };
+  for (const auto& c : kCases) {
+    EXPECT_TRUE(DecodeBase64To(c[0], &bytes)) << c[0];
+    EXPECT_EQ(std::string(bytes.begin(), bytes.end()), c[1]);
+  }
+  EXPECT_TRUE(DecodeBase64To("3q2+7w==", &bytes));
+  EXPECT_EQ(bytes, (Bytes{0xde, 0xad, 0xbe, 0xef}));
+  EXPECT_TRUE(DecodeBase64To("//79", &bytes));
+  EXPECT_EQ(bytes, (Bytes{0xff, 0xfe, 0xfd}));
+}
+
+TEST(Encoding, DecodeBase64Strict) {
+  Bytes bytes;
+  // No padding, or too much.
+  EXPECT_FALSE(DecodeBase64To("Zg", &bytes));
+  EXPECT_FALSE(DecodeBase64To("Z===", &bytes));
+  EXPECT_FALSE(DecodeBase64To("====", &bytes));
+  // Padding only at the end.
+  EXPECT_FALSE(DecodeBase64To("Zg==Zm9v", &bytes));
+  EXPECT_FALSE(DecodeBase64To("Z=g=", &bytes));
+  // Out of the alphabet, including the URL-safe one.
+  EXPECT_FALSE(DecodeBase64To("Zm9-", &bytes));
+  EXPECT_FALSE(DecodeBase64To("Zm9_Zm9v", &bytes));
+  EXPECT_FALSE(DecodeBase64To("Zm 9", &bytes));
+  // The dropped bits are not 0.
+  EXPECT_FALSE(DecodeBase64To("Zh==", &bytes));
+  EXPECT_FALSE(DecodeBase64To("Zm9=", &bytes));
+
+  std::array<std::uint8_t, 3> array{};
+  EXPECT_TRUE(DecodeBase64To("Zm9v", &array));
+  EXPECT_FALSE(DecodeBase64To("Zm8=", &array));
+}
+
+}  // namespace testing_internal
+}  // namespace internal
+}  // namespace argparse
@@ -42,19 +42,20 @@ void RegisterGlagsArgument(const RegisterParams& params) {
 }
 
 template <typename... Types>
-bool IsGflagsSupportedTypeImpl(std::type_index type, TypeList<Types...>) {
+bool IsGflagsSupportedTypeImpl(TypeTag type, TypeList<Types...>) {
   const std::array<bool, sizeof...(Types)> matches{
-      {(type == typeid(Types))...}};
-  return std::find(matches.begin(), matches.end(), true);
+      {(type == TypeTag::Of<Types>())...}};
+  return std::find(matches.begin(), matches.end(), true) != matches.end();
 }
 
-bool IsGflagsSupportedType(std::type_index type) {
+bool IsGflagsSupportedType(TypeTag type) {
   return IsGflagsSupportedTypeImpl(type, GflagsTypeList{});
 }
 
 template <typename... Types>
 GflagsRegisterMap CreateRegisterMap(TypeList<Types...>) {
-  return GflagsRegisterMap{{typeid(Types), &RegisterGlagsArgument<Types>}...};
+  return GflagsRegisterMap{
+      {TypeTag::Of<Types>(), &RegisterGlagsArgument<Types>}...};
 }
 
 }  // namespace
@@ -76,17 +77,29 @@ void GflagsParser::SetOption(ParserOptions key, absl::string_view value) {
   }
 }
 
-bool GflagsParser::ParseKnownArgs(ArgArray args,
-                                  std::vector<std::string>* unparsed_args) {
-  int argc = args.GetArgc();
-  char** argv = args.GetArgv();
-
-  auto rv = gflags::ParseCommandLineFlags(&argc, &argv, true);
-  if (unparsed_args) {
-    for (int i = 0; i < argc; ++i) unparsed_args->push_back(argv[i]);
-    return rv == 0;
+// The values are stored by gflags itself, so only the tokens are charged to
+// the budget.
+absl::Status GflagsParser::ParseKnownArgs(ArgArray args,
+                                          ParseBudgetTracker* budget,
+                                          std::vector<int>* unknown) {
+  // gflags moves the tokens it leaves to the front, so give it a copy of the
+  // pointers and leave the caller's argv alone.
+  ArgvBuffer buffer(args);
+  auto* original = buffer.GetArgv();
+  std::vector<char*> copy(original, original + buffer.GetArgc());
+  int argc = buffer.GetArgc();
+  auto* argv = copy.data();
+
+  // The result is the index of the first token left, not an error: gflags
+  // reports a bad flag and exits by itself.
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  if (unknown) {
+    // gflags puts the tokens after "--" before the other ones it leaves, so
+    // find each one by its pointer. argv[0] is the program name rather than
+    // an unknown token.
+    buffer.FindIndices(absl::MakeConstSpan(argv + 1, argc - 1), unknown);
   }
-  return true;
+  return absl::OkStatus();
 }
 
 void GflagsParser::Initialize(ArgumentContainer* container) {
@@ -129,6 +142,16 @@ void GflagsParser::Initialize(ArgumentContainer* container) {
   }
 }
 
+void GflagsParser::AddMemoryUsage(MemoryUsage* usage) const {
+  usage->AddObject(*this);
+  // A node of std::map holds the value, three links and a color.
+  for (std::size_t i = 0; i < register_map_.size(); ++i) {
+    usage->AddAllocation(sizeof(GflagsRegisterMap::value_type) +
+                         4 * sizeof(void*));
+  }
+  // The flags registered in gflags itself are not counted.
+}
+
 GflagsParser::~GflagsParser() { gflags::ShutDownCommandLineFlags(); }
 
 }  // namespace gflags_parser_internal
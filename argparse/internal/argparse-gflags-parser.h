@@ -24,15 +24,16 @@ struct RegisterParams {
 };
 
 using GflagRegisterFunc = void (*)(const RegisterParams&);
-using GflagsRegisterMap = std::map<std::type_index, GflagRegisterFunc>;
+using GflagsRegisterMap = std::map<TypeTag, GflagRegisterFunc>;
 
 class GflagsParser final : public ArgumentParser {
  public:
   GflagsParser();
   void SetOption(ParserOptions key, absl::string_view value) override;
   void Initialize(ArgumentContainer* container) override;
-  bool ParseKnownArgs(ArgArray args,
-                      std::vector<std::string>* unparsed_args) override;
+  absl::Status ParseKnownArgs(ArgArray args, ParseBudgetTracker* budget,
+                              std::vector<int>* unknown) override;
+  void AddMemoryUsage(MemoryUsage* usage) const override;
   ~GflagsParser() override;
 
  private:
@@ -16,6 +16,7 @@ namespace {
 class NumberNumArgsInfo : public NumArgsInfo {
  public:
   explicit NumberNumArgsInfo(unsigned num) : num_(num) {}
+  unsigned GetCount() const override { return num_; }
   bool Run(unsigned in, std::string* errmsg) override {
     if (in == num_) return true;
     std::ostringstream os;
@@ -24,6 +25,10 @@ class NumberNumArgsInfo : public NumArgsInfo {
     return false;
   }
 
+  void AddMemoryUsage(MemoryUsage* usage) const override {
+    usage->AddObject(*this);
+  }
+
  private:
   const unsigned num_;
 };
@@ -32,12 +37,17 @@ class FlagNumArgsInfo : public NumArgsInfo {
  public:
   explicit FlagNumArgsInfo(char flag);
   bool Run(unsigned in, std::string* errmsg) override;
+  bool TakesMany() const override { return flag_ == '*' || flag_ == '+'; }
+
+  void AddMemoryUsage(MemoryUsage* usage) const override {
+    usage->AddObject(*this);
+  }
 
  private:
   const char flag_;
 };
 
-bool IsValidNumArgsFlag(char in) { return in == '+' || in == '*' || in == '+'; }
+bool IsValidNumArgsFlag(char in) { return in == '+' || in == '*' || in == '?'; }
 
 const char* FlagToString(char flag) {
   switch (flag) {
@@ -64,6 +74,7 @@ bool FlagNumArgsInfo::Run(unsigned in, std::string* errmsg) {
       break;
     case '*':
       ok = true;
+      break;
     default:
       ARGPARSE_DCHECK(false);
   }
@@ -89,6 +100,15 @@ class DefaultTypeInfo final : public TypeInfo {
     ARGPARSE_DCHECK(GetOps()->IsSupported(OpsKind::kParse));
     return GetOps()->Parse(in, out);
   }
+  bool ParseInPlace(absl::string_view in, OpaquePtr out,
+                    std::string* errmsg) override {
+    ARGPARSE_DCHECK(GetOps()->IsSupported(OpsKind::kParse));
+    return GetOps()->ParseInPlace(in, out, errmsg);
+  }
+  bool IsDefault() const override { return true; }
+  void AddMemoryUsage(MemoryUsage* usage) const override {
+    usage->AddObject(*this);
+  }
 };
 
 // TypeInfo that opens a file according to some mode.
@@ -103,6 +123,10 @@ class FileTypeInfo final : public TypeInfo {
     return GetOps()->Open(in, mode_, out);
   }
 
+  void AddMemoryUsage(MemoryUsage* usage) const override {
+    usage->AddObject(*this);
+  }
+
  private:
   absl::string_view mode_;
 };
@@ -126,7 +150,11 @@ class ActionWithDest : public ActionInfo {
 class CountAction final : public ActionWithDest {
  public:
   using ActionWithDest::ActionWithDest;
-  void Run(std::unique_ptr<Any>) override { GetOps()->Count(GetPtr()); }
+  void Run(Any) override { GetOps()->Count(GetPtr()); }
+  bool ConsumesValue() const override { return false; }
+  void AddMemoryUsage(MemoryUsage* usage) const override {
+    usage->AddObject(*this);
+  }
 };
 
 // Actions that don't use the input data, but use a pre-set constant.
@@ -136,6 +164,7 @@ class ActionWithConst : public ActionWithDest {
       : ActionWithDest(dest), const_value_(const_value) {
     ARGPARSE_DCHECK(const_value_);
   }
+  bool ConsumesValue() const override { return false; }
 
  protected:
   const Any& GetConstValue() const { return *const_value_; }
@@ -148,38 +177,168 @@ class ActionWithConst : public ActionWithDest {
 class StoreConstAction final : public ActionWithConst {
  public:
   using ActionWithConst::ActionWithConst;
-  void Run(std::unique_ptr<Any>) override {
+  void Run(Any) override {
     GetOps()->StoreConst(GetPtr(), GetConstValue());
   }
+  void AddMemoryUsage(MemoryUsage* usage) const override {
+    usage->AddObject(*this);
+  }
 };
 
 class AppendConstAction final : public ActionWithConst {
  public:
   using ActionWithConst::ActionWithConst;
-  void Run(std::unique_ptr<Any>) override {
+  void Run(Any) override {
     GetOps()->AppendConst(GetPtr(), GetConstValue());
   }
+  bool AppendsToDest() const override { return true; }
+  void AddMemoryUsage(MemoryUsage* usage) const override {
+    usage->AddObject(*this);
+  }
 };
 
 class AppendAction final : public ActionWithDest {
  public:
   using ActionWithDest::ActionWithDest;
-  void Run(std::unique_ptr<Any> data) override {
+  void Run(Any data) override {
     GetOps()->Append(GetPtr(), std::move(data));
   }
+  bool RunsManyInPlace() const override { return true; }
+  bool RunManyInPlace(TypeInfo* type,
+                      absl::Span<const absl::string_view> values,
+                      std::size_t max_threads, std::size_t* bad_index,
+                      std::string* errmsg) override {
+    if (type->IsDefault()) {
+      return GetOps()->AppendEachDefault(GetPtr(), values, max_threads,
+                                         bad_index, errmsg);
+    }
+    auto parse = [type](absl::string_view value, OpaquePtr out,
+                        std::string* msg) {
+      return type->ParseInPlace(value, out, msg);
+    };
+    return GetOps()->AppendEach(GetPtr(), values, parse, bad_index, errmsg);
+  }
+  bool AppendsToDest() const override { return true; }
+  void AddMemoryUsage(MemoryUsage* usage) const override {
+    usage->AddObject(*this);
+  }
+};
+
+// Append the pieces of a delimited list in place, without copying them out of
+// the command line first.
+class SplitAppendAction final : public ActionWithDest {
+ public:
+  SplitAppendAction(DestInfo* dest, char delimiter)
+      : ActionWithDest(dest), delimiter_(delimiter) {
+    ARGPARSE_DCHECK(GetOps()->IsSupported(OpsKind::kAppend));
+  }
+  // Without a value there is nothing to append.
+  void Run(Any) override {}
+  bool RunsInPlace() const override { return true; }
+  bool RunInPlace(TypeInfo* type, absl::string_view in,
+                  std::string* errmsg) override {
+    if (type->IsDefault())
+      return GetOps()->AppendSplitDefault(GetPtr(), in, delimiter_, errmsg);
+    auto parse = [type](absl::string_view piece, OpaquePtr out,
+                        std::string* msg) {
+      return type->ParseInPlace(piece, out, msg);
+    };
+    return GetOps()->AppendSplit(GetPtr(), in, delimiter_, parse, errmsg);
+  }
+  bool AppendsToDest() const override { return true; }
+  std::size_t GetValueCount(absl::string_view in) const override {
+    return 1 + CountChar(in, delimiter_);
+  }
+  void AddMemoryUsage(MemoryUsage* usage) const override {
+    usage->AddObject(*this);
+  }
+
+ private:
+  char delimiter_;
+};
+
+// Insert the pairs of a value like "a=1,b=2" into a map in place. The halves
+// are parsed with the key and mapped types' own Parse(), so `type` is unused.
+class InsertAction final : public ActionWithDest {
+ public:
+  InsertAction(DestInfo* dest, char delimiter, DuplicateKey policy)
+      : ActionWithDest(dest), delimiter_(delimiter), policy_(policy) {
+    ARGPARSE_DCHECK(GetOps()->IsSupported(OpsKind::kInsert));
+  }
+  // Without a value there is nothing to insert.
+  void Run(Any) override {}
+  bool RunsInPlace() const override { return true; }
+  bool RunInPlace(TypeInfo*, absl::string_view in,
+                  std::string* errmsg) override {
+    return GetOps()->InsertSplit(GetPtr(), in, delimiter_, policy_, errmsg);
+  }
+  bool AppendsToDest() const override { return true; }
+  std::size_t GetValueCount(absl::string_view in) const override {
+    return delimiter_ ? 1 + CountChar(in, delimiter_) : 1;
+  }
+  void AddMemoryUsage(MemoryUsage* usage) const override {
+    usage->AddObject(*this);
+  }
+
+ private:
+  char delimiter_;
+  DuplicateKey policy_;
+};
+
+// Parse the values right into the elements of a tuple or a fixed-capacity
+// array.
+class ElementsAction final : public ActionWithDest {
+ public:
+  ElementsAction(DestInfo* dest, char delimiter)
+      : ActionWithDest(dest), delimiter_(delimiter) {
+    ARGPARSE_DCHECK(GetOps()->IsSupported(OpsKind::kStoreElements));
+  }
+  void Run(Any) override {}
+  bool RunsInPlace() const override { return true; }
+  bool RunInPlace(TypeInfo*, absl::string_view in,
+                  std::string* errmsg) override {
+    return GetOps()->StoreElementsSplit(GetPtr(), in, delimiter_, errmsg);
+  }
+  bool RunsManyInPlace() const override { return true; }
+  bool RunManyInPlace(TypeInfo*, absl::Span<const absl::string_view> values,
+                      std::size_t, std::size_t* bad_index,
+                      std::string* errmsg) override {
+    return GetOps()->StoreElements(GetPtr(), values, bad_index, errmsg);
+  }
+  void AddMemoryUsage(MemoryUsage* usage) const override {
+    usage->AddObject(*this);
+  }
+
+ private:
+  char delimiter_;
 };
 
 class StoreAction final : public ActionWithDest {
  public:
   // TODO: should check supportness in ctor.
   using ActionWithDest::ActionWithDest;
-  void Run(std::unique_ptr<Any> data) override {
+  void Run(Any data) override {
     GetOps()->Store(GetPtr(), std::move(data));
   }
+  void AddMemoryUsage(MemoryUsage* usage) const override {
+    usage->AddObject(*this);
+  }
 };
 
 }  // namespace
 
+bool TypeInfo::ParseInPlace(absl::string_view in, OpaquePtr out,
+                            std::string* errmsg) {
+  OpsResult result;
+  Run(in, &result);
+  if (result.has_error) {
+    *errmsg = std::move(result.errmsg);
+    return false;
+  }
+  GetOps()->Store(out, std::move(result.value));
+  return true;
+}
+
 std::unique_ptr<TypeInfo> TypeInfo::CreateDefault(Operations* ops) {
   return absl::make_unique<DefaultTypeInfo>(ops);
 }
@@ -223,6 +382,37 @@ std::unique_ptr<ActionInfo> ActionInfo::CreateBuiltinAction(
   }
 }
 
+std::unique_ptr<ActionInfo> ActionInfo::CreateSplitAppendAction(
+    DestInfo* dest, char delimiter) {
+  return absl::make_unique<SplitAppendAction>(dest, delimiter);
+}
+
+std::unique_ptr<ActionInfo> ActionInfo::CreateInsertAction(
+    DestInfo* dest, char delimiter, DuplicateKey policy) {
+  return absl::make_unique<InsertAction>(dest, delimiter, policy);
+}
+
+std::unique_ptr<ActionInfo> ActionInfo::CreateElementsAction(DestInfo* dest,
+                                                            char delimiter) {
+  return absl::make_unique<ElementsAction>(dest, delimiter);
+}
+
+namespace info_internal {
+
+int CompareChoiceNames(absl::string_view a, absl::string_view b,
+                       EnumCase match) {
+  if (match == EnumCase::kSensitive) return a.compare(b);
+  auto size = std::min(a.size(), b.size());
+  for (std::size_t i = 0; i < size; ++i) {
+    auto x = static_cast<unsigned char>(absl::ascii_tolower(a[i]));
+    auto y = static_cast<unsigned char>(absl::ascii_tolower(b[i]));
+    if (x != y) return x < y ? -1 : 1;
+  }
+  return a.size() == b.size() ? 0 : a.size() < b.size() ? -1 : 1;
+}
+
+}  // namespace info_internal
+
 bool NamesInfo::IsValidPositionalName(absl::string_view name) {
   if (name.empty() || !absl::ascii_isalpha(name[0])) return false;
   return std::all_of(name.begin() + 1, name.end(), &IsValidBodyChar);
@@ -242,28 +432,34 @@ std::unique_ptr<NamesInfo> NamesInfo::CreatePositionalName(
 }
 
 std::unique_ptr<NamesInfo> NamesInfo::CreateOptionalNames(
-    std::initializer_list<absl::string_view> names) {
+    absl::Span<const absl::string_view> names) {
   return absl::WrapUnique(new NamesInfo(names));
 }
 
 std::unique_ptr<NamesInfo> NamesInfo::CreateSingleName(absl::string_view name) {
   return IsValidPositionalName(name) ? CreatePositionalName(name)
-                                     : CreateOptionalNames({name});
+                                     : CreateOptionalNames({&name, 1});
 }
 
 NamesInfo::NamesInfo(absl::string_view name) : is_optional_(false) {
   ARGPARSE_CHECK_F(IsValidPositionalName(name),
                    "Not a valid positional name: '%s'", name.data());
-  names_.push_back(std::string(name));
+  names_.push_back(name);
 }
 
 // The ctor for optional names.
-NamesInfo::NamesInfo(std::initializer_list<absl::string_view> names)
+NamesInfo::NamesInfo(absl::Span<const absl::string_view> names)
     : is_optional_(true) {
   for (auto name : names) {
     ARGPARSE_CHECK_F(IsValidOptionalName(name),
                      "Not a valid optional name: '%s'", name.data());
-    names_.push_back(std::string(name));
+    names_.push_back(name);
+  }
+}
+
+void NamesInfo::InternNames(const StringPool& local, StringPool* shared) {
+  for (auto& name : names_) {
+    if (local.Owns(name)) name = shared->Intern(name);
   }
 }
 
@@ -5,13 +5,20 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <initializer_list>
 #include <memory>
+#include <vector>
 
-#include "absl/container/flat_hash_map.h"
 #include "absl/container/inlined_vector.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "argparse/internal/argparse-memory-usage.h"
 #include "argparse/internal/argparse-operations.h"
+#include "argparse/internal/argparse-string-pool.h"
 
 namespace argparse {
 namespace internal {
@@ -59,7 +66,7 @@ class NamesInfo final {
   // For an optional, this is the first long name (or first short name).
   // absl::string_view GetRepresentativeName() const;
 
-  std::string GetDefaultMetaVar() const { return {}; }
+  absl::string_view GetDefaultMetaVar() const { return {}; }
 
   // Invoke a callback for each name that satisfies the predicate.
   // Example:
@@ -109,6 +116,18 @@ class NamesInfo final {
     return IsOptionalName(name) && name.size() == 2;
   }
 
+  // Replace the names that live in `local` by copies interned in `shared`.
+  void InternNames(const StringPool& local, StringPool* shared);
+
+  // Count the memory of this object, but not of the names it refers to.
+  void AddMemoryUsage(MemoryUsage* usage) const {
+    usage->AddObject(*this);
+    usage->AddBuffer(names_);
+  }
+
+  // NamesInfo keeps views of the names, so the caller must keep them alive
+  // (see SpecString and StringPool).
+
   // Given a single name, it can be an optional or positional one.
   // This method deals with the differences and create it correctly.
   static std::unique_ptr<NamesInfo> CreateSingleName(absl::string_view name);
@@ -121,7 +140,7 @@ class NamesInfo final {
   // this method only works for optional names and will check for that.
   // You must ensure that each name must be an optional one.
   static std::unique_ptr<NamesInfo> CreateOptionalNames(
-      std::initializer_list<absl::string_view> names);
+      absl::Span<const absl::string_view> names);
 
   static constexpr char kOptionalPrefixChar = '-';
   static constexpr char kUnderscoreChar = '_';
@@ -130,12 +149,12 @@ class NamesInfo final {
   static bool IsValidBodyChar(char c);
 
   // Ctor for constructing optional names.
-  explicit NamesInfo(std::initializer_list<absl::string_view> optional_names);
+  explicit NamesInfo(absl::Span<const absl::string_view> optional_names);
   // Ctor for constructing positional names.
   explicit NamesInfo(absl::string_view positional_name);
 
   bool is_optional_;
-  absl::InlinedVector<std::string, 1> names_;
+  absl::InlinedVector<absl::string_view, 1> names_;
 };
 
 class NumArgsInfo {
@@ -144,19 +163,29 @@ class NumArgsInfo {
   // Run() checks if num is valid by returning bool.
   // If invalid, error msg will be set.
   virtual bool Run(unsigned num, std::string* errmsg) = 0;
+  // Whether any number of values may be given, i.e., '*' or '+'.
+  virtual bool TakesMany() const { return false; }
+  // The exact number of values, or 0 if it is not fixed.
+  virtual unsigned GetCount() const { return 0; }
+  // Count the memory of this object, which is allocated on its own.
+  virtual void AddMemoryUsage(MemoryUsage* usage) const = 0;
   static std::unique_ptr<NumArgsInfo> CreateFlag(char flag);
   static std::unique_ptr<NumArgsInfo> CreateNumber(int num);
 };
 
+// The Operations already identifies the type of dest, so only the raw pointer
+// is kept next to it.
 class DestInfo final {
  public:
-  OpaquePtr GetDestPtr() const { return dest_ptr_; }
+  OpaquePtr GetDestPtr() const { return OpaquePtr(GetType(), dest_); }
   Operations* GetOperations() const { return operations_; }
   // Query the Operations of value-type of T, if any.
   Operations* GetValueTypeOps() const {
     return GetOperations()->GetValueTypeOps();
   }
-  std::type_index GetType() const { return dest_ptr_.type(); }
+  TypeTag GetType() const { return operations_->GetTypeTag(); }
+
+  void AddMemoryUsage(MemoryUsage* usage) const { usage->AddObject(*this); }
 
   template <typename T>
   static std::unique_ptr<DestInfo> CreateFromPtr(T* ptr);
@@ -164,19 +193,61 @@ class DestInfo final {
  private:
   template <typename T>
   explicit DestInfo(T* ptr)
-      : dest_ptr_(ptr), operations_(Operations::GetInstance<T>()) {}
+      : dest_(ptr), operations_(Operations::GetInstance<T>()) {}
 
-  OpaquePtr dest_ptr_;
+  void* dest_;
   Operations* operations_;
 };
 
+class TypeInfo;
+
 class ActionInfo {
  public:
   virtual ~ActionInfo() {}
-  virtual void Run(std::unique_ptr<Any> data) = 0;
+  virtual void Run(Any data) = 0;
+  // Parse `in` with `type` and run on the result without putting it into an
+  // Any. Only actions that use the value on the spot support this.
+  virtual bool RunsInPlace() const { return false; }
+  virtual bool RunInPlace(TypeInfo* /*type*/, absl::string_view /*in*/,
+                          std::string* /*errmsg*/) {
+    return false;
+  }
+  // Parse all of `values` with `type` and run on each of them, on up to
+  // `max_threads` threads if there are many. On failure, `*bad_index` is the
+  // index of the bad value.
+  virtual bool RunsManyInPlace() const { return false; }
+  virtual bool RunManyInPlace(TypeInfo* /*type*/,
+                              absl::Span<const absl::string_view> /*values*/,
+                              std::size_t /*max_threads*/,
+                              std::size_t* /*bad_index*/,
+                              std::string* /*errmsg*/) {
+    return false;
+  }
+  // Whether Run() adds an element to the dest, which makes it grow.
+  virtual bool AppendsToDest() const { return false; }
+  // The number of elements added for the value `in`, if AppendsToDest().
+  virtual std::size_t GetValueCount(absl::string_view /*in*/) const {
+    return 1;
+  }
+  // Whether Run() takes a value from the command line.
+  virtual bool ConsumesValue() const { return true; }
+  // Count the memory of this object, which is allocated on its own.
+  virtual void AddMemoryUsage(MemoryUsage* usage) const = 0;
 
   static std::unique_ptr<ActionInfo> CreateBuiltinAction(
       ActionKind action_kind, DestInfo* dest, const Any* const_value);
+  // Append each piece of a value split on `delimiter`, like "a,b,c".
+  static std::unique_ptr<ActionInfo> CreateSplitAppendAction(DestInfo* dest,
+                                                             char delimiter);
+  // Insert each "key=value" into a map, split on `delimiter` unless it is
+  // '\0'.
+  static std::unique_ptr<ActionInfo> CreateInsertAction(DestInfo* dest,
+                                                        char delimiter,
+                                                        DuplicateKey policy);
+  // Parse one value into each element of a tuple or a fixed-capacity array.
+  // An option has only one value, where they are separated by `delimiter`.
+  static std::unique_ptr<ActionInfo> CreateElementsAction(DestInfo* dest,
+                                                          char delimiter);
   template <typename T>
   static std::unique_ptr<ActionInfo> CreateCallbackAction(
       ActionCallback<T> func);
@@ -185,10 +256,35 @@ class ActionInfo {
 template <typename T>
 using EnumValues = std::initializer_list<std::pair<absl::string_view, T>>;
 
+// How the names of enum choices are matched.
+enum class EnumCase {
+  kSensitive,
+  // ASCII letters match regardless of case.
+  kInsensitive,
+};
+
+// A choice of an enum type. An array of them can be a constexpr table:
+//   static constexpr EnumChoice<Color> kColors[] = {
+//       {"blue", Color::kBlue}, {"red", Color::kRed}};
+template <typename T>
+struct EnumChoice {
+  absl::string_view name;
+  T value;
+};
+
 class TypeInfo {
  public:
   virtual ~TypeInfo() {}
   virtual void Run(absl::string_view in, OpsResult* out) = 0;
+  // Like Run(), but right into `out`, which points to a T of GetOps(). This
+  // version goes through Run() and stores the Any.
+  virtual bool ParseInPlace(absl::string_view in, OpaquePtr out,
+                            std::string* errmsg);
+  // Whether this is just the Parse() of GetOps(), so the ops can be used
+  // directly.
+  virtual bool IsDefault() const { return false; }
+  // Count the memory of this object, which is allocated on its own.
+  virtual void AddMemoryUsage(MemoryUsage* usage) const = 0;
 
   // Default version: parse a single string into value.
   static std::unique_ptr<TypeInfo> CreateDefault(Operations* ops);
@@ -197,7 +293,13 @@ class TypeInfo {
                                                   absl::string_view mode);
 
   template <typename T>
-  static std::unique_ptr<TypeInfo> CreateEnumType(EnumValues<T> values);
+  static std::unique_ptr<TypeInfo> CreateEnumType(EnumValues<T> values,
+                                                  EnumCase match);
+  // Unlike CreateEnumType(), `table` is not copied, so it must outlive the
+  // parser.
+  template <typename T>
+  static std::unique_ptr<TypeInfo> CreateEnumTable(
+      absl::Span<const EnumChoice<T>> table, EnumCase match);
 
   template <typename T>
   static std::unique_ptr<TypeInfo> CreateCallbackType(TypeCallback<T> cb);
@@ -220,32 +322,158 @@ class CallbackTypeInfo : public TypeInfo {
       : TypeInfo(Operations::GetInstance<T>()), callback_(std::move(cb)) {}
 
   void Run(absl::string_view in, OpsResult* out) override {
-    T return_value;
-    bool rv = callback_(in, &return_value);
-    // *out = OpsResult(rv ? ConversionSuccess(std::move_if_noexcept(return_value))
-    //                     : ConversionFailure());
+    T value;
+    if (ParseInPlace(in, OpaquePtr(&value), &out->errmsg)) {
+      out->value = MakeAny<T>(std::move_if_noexcept(value));
+      return;
+    }
+    out->has_error = true;
+  }
+
+  bool ParseInPlace(absl::string_view in, OpaquePtr out,
+                    std::string* errmsg) override {
+    if (callback_(in, out.Cast<T>())) return true;
+    *errmsg = "invalid " + TypeHint<T>() + " value";
+    return false;
+  }
+
+  // What the callback allocates is not known.
+  void AddMemoryUsage(MemoryUsage* usage) const override {
+    usage->AddObject(*this);
   }
 
  private:
   CallbackType callback_;
 };
 
+// Compare two choice names under `match`, like absl::string_view::compare().
+int CompareChoiceNames(absl::string_view a, absl::string_view b,
+                       EnumCase match);
+
+// Looks a name up among the choices by a binary search over them sorted by
+// name. If the choices are sorted already (a table may be written that way),
+// no index is built at all.
 template <typename T>
 class EnumTypeInfo final : public TypeInfo {
  public:
-  explicit EnumTypeInfo(EnumValues<T> values)
-      : TypeInfo(Operations::GetInstance<T>()) {
+  // Refer to `choices` in place, so they must outlive this.
+  EnumTypeInfo(absl::Span<const EnumChoice<T>> choices, EnumCase match)
+      : TypeInfo(Operations::GetInstance<T>()),
+        choices_(choices),
+        match_(match) {
+    BuildIndex();
+  }
+
+  // Keep a copy of `values`, with all the names in one buffer.
+  EnumTypeInfo(EnumValues<T> values, EnumCase match)
+      : TypeInfo(Operations::GetInstance<T>()), match_(match) {
+    std::size_t size = 0;
+    for (const auto& val : values) size += val.first.size();
+    names_.reserve(size);
+    for (const auto& val : values)
+      names_.append(val.first.data(), val.first.size());
+    owned_.reserve(values.size());
+    std::size_t offset = 0;
     for (const auto& val : values) {
-      value_map_.emplace(val.first, val.second);
+      owned_.push_back({absl::string_view(names_).substr(offset,
+                                                          val.first.size()),
+                        val.second});
+      offset += val.first.size();
     }
+    choices_ = owned_;
+    BuildIndex();
   }
 
   void Run(absl::string_view in, OpsResult* out) override {
-    auto iter = value_map_.find(in);
+    T value;
+    if (ParseInPlace(in, OpaquePtr(&value), &out->errmsg)) {
+      out->value = MakeAny<T>(value);
+      return;
+    }
+    out->has_error = true;
+  }
+
+  bool ParseInPlace(absl::string_view in, OpaquePtr out,
+                    std::string* errmsg) override {
+    if (const auto* choice = Find(in)) {
+      *out.Cast<T>() = choice->value;
+      return true;
+    }
+    *errmsg = FormatChoices();
+    return false;
+  }
+
+  void AddMemoryUsage(MemoryUsage* usage) const override {
+    usage->AddObject(*this);
+    usage->AddBuffer(names_);
+    usage->AddBuffer(owned_);
+    usage->AddBuffer(order_);
   }
 
  private:
-  absl::flat_hash_map<std::string, T> value_map_;
+  const EnumChoice<T>& GetSorted(std::size_t i) const {
+    return order_.empty() ? choices_[i] : choices_[order_[i]];
+  }
+
+  int Compare(absl::string_view a, absl::string_view b) const {
+    return CompareChoiceNames(a, b, match_);
+  }
+
+  // Sort the choices into order_ unless they are sorted already. Two names
+  // that are the same under match_ are an error.
+  void BuildIndex() {
+    for (std::size_t i = 1; i < choices_.size(); ++i) {
+      if (Compare(choices_[i - 1].name, choices_[i].name) < 0) continue;
+      order_.resize(choices_.size());
+      for (std::size_t j = 0; j < order_.size(); ++j)
+        order_[j] = static_cast<std::uint32_t>(j);
+      std::sort(order_.begin(), order_.end(),
+                [this](std::uint32_t a, std::uint32_t b) {
+                  return Compare(choices_[a].name, choices_[b].name) < 0;
+                });
+      break;
+    }
+    for (std::size_t i = 1; i < choices_.size(); ++i) {
+      auto name = GetSorted(i).name;
+      ARGPARSE_CHECK_F(Compare(GetSorted(i - 1).name, name) != 0,
+                       "Duplicated enum choice: '%s'",
+                       std::string(name).c_str());
+    }
+  }
+
+  const EnumChoice<T>* Find(absl::string_view name) const {
+    std::size_t low = 0, high = choices_.size();
+    while (low < high) {
+      auto mid = low + (high - low) / 2;
+      const auto& choice = GetSorted(mid);
+      int result = Compare(choice.name, name);
+      if (result == 0) return &choice;
+      if (result < 0)
+        low = mid + 1;
+      else
+        high = mid;
+    }
+    return nullptr;
+  }
+
+  // "invalid choice (choose from 'a', 'b', 'c')", with a long list cut off.
+  std::string FormatChoices() const {
+    constexpr std::size_t kMaxShown = 8;
+    std::string out = "invalid choice (choose from ";
+    for (std::size_t i = 0; i < choices_.size() && i < kMaxShown; ++i)
+      absl::StrAppend(&out, i ? ", '" : "'", choices_[i].name, "'");
+    if (choices_.size() > kMaxShown) out += ", ...";
+    out += ")";
+    return out;
+  }
+
+  absl::Span<const EnumChoice<T>> choices_;
+  EnumCase match_;
+  // For EnumValues.
+  std::string names_;
+  std::vector<EnumChoice<T>> owned_;
+  // choices_[order_[i]] is the i-th by name, if they are not in order.
+  std::vector<std::uint32_t> order_;
 };
 
 // An action that runs a user-supplied callback.
@@ -254,9 +482,20 @@ class CallbackAction final : public ActionInfo {
  public:
   using CallbackType = ActionCallback<T>;
   explicit CallbackAction(CallbackType&& cb) : callback_(std::move(cb)) {}
-  void Run(std::unique_ptr<Any> data) override {
+  void Run(Any data) override {
     callback_(AnyCast<T>(std::move(data)));
   }
+  bool RunsInPlace() const override { return true; }
+  bool RunInPlace(TypeInfo* type, absl::string_view in,
+                  std::string* errmsg) override {
+    T value;
+    if (!type->ParseInPlace(in, OpaquePtr(&value), errmsg)) return false;
+    callback_(std::move(value));
+    return true;
+  }
+  void AddMemoryUsage(MemoryUsage* usage) const override {
+    usage->AddObject(*this);
+  }
 
  private:
   CallbackType callback_;
@@ -264,8 +503,6 @@ class CallbackAction final : public ActionInfo {
 
 }  // namespace info_internal
 
-// If we can make Operations indexable from type_index, then only an opaque-ptr
-// is needed here.
 template <typename T>
 std::unique_ptr<DestInfo> DestInfo::CreateFromPtr(T* ptr) {
   ARGPARSE_CHECK_F(ptr, "Pointer passed to dest() must not be null.");
@@ -286,8 +523,15 @@ std::unique_ptr<TypeInfo> TypeInfo::CreateCallbackType(TypeCallback<T> cb) {
 }
 
 template <typename T>
-std::unique_ptr<TypeInfo> TypeInfo::CreateEnumType(EnumValues<T> values) {
-  return absl::make_unique<info_internal::EnumTypeInfo<T>>(values);
+std::unique_ptr<TypeInfo> TypeInfo::CreateEnumType(EnumValues<T> values,
+                                                   EnumCase match) {
+  return absl::make_unique<info_internal::EnumTypeInfo<T>>(values, match);
+}
+
+template <typename T>
+std::unique_ptr<TypeInfo> TypeInfo::CreateEnumTable(
+    absl::Span<const EnumChoice<T>> table, EnumCase match) {
+  return absl::make_unique<info_internal::EnumTypeInfo<T>>(table, match);
 }
 
 }  // namespace internal
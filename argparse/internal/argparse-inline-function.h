@@ -0,0 +1,118 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "absl/meta/type_traits.h"
+#include "argparse/internal/argparse-logging.h"
+
+namespace argparse {
+namespace internal {
+
+template <typename Signature,
+          std::size_t Size = sizeof(std::function<Signature>)>
+class InlineFunction;
+
+// A move-only std::function that never allocates: the callable is stored in a
+// buffer of `Size` bytes inside the object, and one that doesn't fit is a
+// compile error. Capture a pointer to the state when it is large. The default
+// size is that of a std::function of the same signature, so an existing one
+// can be passed as is.
+template <typename R, typename... Args, std::size_t Size>
+class InlineFunction<R(Args...), Size> final {
+  // Like std::function, a void one drops the result of any callable.
+  template <typename Result>
+  using IsResultConvertible =
+      absl::disjunction<std::is_void<R>, std::is_convertible<Result, R>>;
+
+ public:
+  InlineFunction() = default;
+  InlineFunction(std::nullptr_t) {}
+
+  template <typename F, typename Fn = absl::decay_t<F>,
+            typename = absl::enable_if_t<
+                !std::is_same<Fn, InlineFunction>::value &&
+                IsResultConvertible<decltype(std::declval<Fn&>()(
+                    std::declval<Args>()...))>::value>>
+  InlineFunction(F&& func) {
+    static_assert(sizeof(Fn) <= Size,
+                  "The callable is too large, capture less or by pointer");
+    static_assert(alignof(Fn) <= alignof(Storage),
+                  "The callable is over-aligned");
+    static_assert(std::is_nothrow_move_constructible<Fn>::value,
+                  "The callable must be nothrow move-constructible");
+    ::new (&storage_) Fn(std::forward<F>(func));
+    invoke_ = &Invoke<Fn>;
+    relocate_or_destroy_ = &RelocateOrDestroy<Fn>;
+  }
+
+  InlineFunction(InlineFunction&& that) noexcept { MoveFrom(&that); }
+  InlineFunction& operator=(InlineFunction&& that) noexcept {
+    if (this != &that) {
+      Reset();
+      MoveFrom(&that);
+    }
+    return *this;
+  }
+  InlineFunction(const InlineFunction&) = delete;
+  InlineFunction& operator=(const InlineFunction&) = delete;
+  ~InlineFunction() { Reset(); }
+
+  explicit operator bool() const { return invoke_ != nullptr; }
+
+  R operator()(Args... args) const {
+    ARGPARSE_INTERNAL_DCHECK(invoke_, "Calling an empty InlineFunction");
+    return invoke_(&storage_, std::forward<Args>(args)...);
+  }
+
+ private:
+  using Storage =
+      typename std::aligned_storage<Size, alignof(std::max_align_t)>::type;
+
+  template <typename Fn>
+  static R Invoke(const Storage* storage, Args&&... args) {
+    // Like std::function, a const call may run a mutable lambda.
+    auto* fn = reinterpret_cast<Fn*>(const_cast<Storage*>(storage));
+    return static_cast<R>((*fn)(std::forward<Args>(args)...));
+  }
+
+  // Destroy the callable in `self`. If `relocate_to` is not null, it is
+  // moved there first.
+  template <typename Fn>
+  static void RelocateOrDestroy(Storage* self, Storage* relocate_to) {
+    auto* fn = reinterpret_cast<Fn*>(self);
+    if (relocate_to) ::new (relocate_to) Fn(std::move(*fn));
+    fn->~Fn();
+  }
+
+  void MoveFrom(InlineFunction* that) {
+    if (!that->invoke_) return;
+    that->relocate_or_destroy_(&that->storage_, &storage_);
+    invoke_ = that->invoke_;
+    relocate_or_destroy_ = that->relocate_or_destroy_;
+    that->invoke_ = nullptr;
+    that->relocate_or_destroy_ = nullptr;
+  }
+
+  void Reset() {
+    if (!invoke_) return;
+    relocate_or_destroy_(&storage_, nullptr);
+    invoke_ = nullptr;
+    relocate_or_destroy_ = nullptr;
+  }
+
+  Storage storage_;
+  R (*invoke_)(const Storage*, Args&&...) = nullptr;
+  void (*relocate_or_destroy_)(Storage*, Storage*) = nullptr;
+};
+
+}  // namespace internal
+}  // namespace argparse
@@ -0,0 +1,92 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "argparse/internal/argparse-inline-function.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "argparse/argparse-builder.h"
+#include "gtest/gtest.h"
+
+namespace argparse {
+namespace internal {
+namespace testing_internal {
+
+TEST(InlineFunction, StoresCallableInline) {
+  int calls = 0;
+  InlineFunction<int(int)> func = [&calls](int x) {
+    ++calls;
+    return x + 1;
+  };
+  ASSERT_TRUE(func);
+  EXPECT_EQ(func(1), 2);
+
+  auto moved = std::move(func);
+  EXPECT_FALSE(func);
+  EXPECT_EQ(moved(2), 3);
+  EXPECT_EQ(calls, 2);
+}
+
+TEST(InlineFunction, DestroysTheCallable) {
+  auto state = std::make_shared<int>(0);
+  {
+    InlineFunction<void()> func = [state] { ++*state; };
+    func();
+    EXPECT_EQ(state.use_count(), 2);
+  }
+  EXPECT_EQ(state.use_count(), 1);
+  EXPECT_EQ(*state, 1);
+}
+
+TEST(InlineFunction, VoidDropsTheResult) {
+  int calls = 0;
+  InlineFunction<void()> func = [&calls] { return ++calls; };
+  func();
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(InlineFunction, TakesStdFunction) {
+  std::function<bool(int&&)> std_func = [](int x) { return x > 0; };
+  InlineFunction<bool(int&&)> func = std_func;
+  EXPECT_TRUE(func(1));
+  EXPECT_FALSE(func(-1));
+}
+
+// gflags has no callback flags.
+#ifdef ARGPARSE_USE_ARGP
+TEST(InlineFunction, CallbacksRunOnTheParsedValue) {
+  std::string seen;
+  int dest = 0;
+  argparse::ArgumentParser parser;
+  parser.AddArgument(argparse::Argument("--name", &seen)
+                         .Action([&seen](std::string&& value) {
+                           seen = std::move(value);
+                           return true;
+                         }));
+  parser.AddArgument(argparse::Argument("--num", &dest)
+                         .Type([](absl::string_view in, int* out) {
+                           *out = static_cast<int>(in.size());
+                           return !in.empty();
+                         }));
+
+  const char* argv[] = {"prog", "--name=value", "--num=abc"};
+  std::vector<int> unknown;
+  auto status = parser.TryParseKnownArgs(3, argv, &unknown);
+  EXPECT_TRUE(status.ok()) << status;
+  EXPECT_EQ(seen, "value");
+  EXPECT_EQ(dest, 3);
+
+  const char* bad[] = {"prog", "--num="};
+  EXPECT_TRUE(absl::IsInvalidArgument(
+      parser.TryParseKnownArgs(2, bad, &unknown)));
+}
+
+#endif  // ARGPARSE_USE_ARGP
+
+}  // namespace testing_internal
+}  // namespace internal
+}  // namespace argparse
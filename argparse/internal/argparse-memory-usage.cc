@@ -0,0 +1,57 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "argparse/internal/argparse-memory-usage.h"
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+
+namespace argparse {
+namespace internal {
+
+namespace {
+
+void AppendUsage(absl::string_view indent, absl::string_view name,
+                 const MemoryUsage& usage, std::string* out) {
+  absl::StrAppendFormat(out, "%s%-12s %10d bytes %8d allocations\n", indent,
+                        name, usage.bytes, usage.allocations);
+}
+
+void AppendEntries(absl::string_view title,
+                   const std::vector<MemoryReport::Entry>& entries,
+                   std::string* out) {
+  if (entries.empty()) return;
+  absl::StrAppend(out, title, ":\n");
+  for (const auto& entry : entries)
+    AppendUsage("  ", entry.name, entry.usage, out);
+}
+
+}  // namespace
+
+void MemoryReport::AddKinds(const MemoryReport& that) {
+  arguments += that.arguments;
+  names += that.names;
+  strings += that.strings;
+  values += that.values;
+  groups += that.groups;
+  backend += that.backend;
+}
+
+std::string MemoryReport::DebugString() const {
+  std::string out;
+  AppendUsage("", "arguments", arguments, &out);
+  AppendUsage("", "names", names, &out);
+  AppendUsage("", "strings", strings, &out);
+  AppendUsage("", "values", values, &out);
+  AppendUsage("", "groups", groups, &out);
+  AppendUsage("", "backend", backend, &out);
+  AppendUsage("", "total", GetTotal(), &out);
+  AppendEntries("per group", per_group, &out);
+  AppendEntries("per subcommand", per_subcommand, &out);
+  return out;
+}
+
+}  // namespace internal
+}  // namespace argparse
@@ -0,0 +1,135 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+
+namespace argparse {
+namespace internal {
+
+// The heap memory used by some part of a parser: the bytes asked from the
+// allocator and the number of allocations. The figures are computed from
+// object sizes and container capacities, so the overhead of the allocator is
+// not included.
+struct MemoryUsage {
+  std::size_t bytes = 0;
+  std::size_t allocations = 0;
+
+  // Count an allocation of `size` bytes. Nothing is counted for zero.
+  void AddAllocation(std::size_t size) {
+    if (size == 0) return;
+    bytes += size;
+    ++allocations;
+  }
+
+  // Count an object allocated on its own.
+  template <typename T>
+  void AddObject(const T&) {
+    AddAllocation(sizeof(T));
+  }
+
+  // Count the heap buffer of a contiguous container (std::string,
+  // std::vector, absl::InlinedVector...). A buffer that lives inside the
+  // container itself (small string or inlined storage) is not counted.
+  template <typename C>
+  void AddBuffer(const C& container) {
+    const char* data = reinterpret_cast<const char*>(container.data());
+    const char* self = reinterpret_cast<const char*>(&container);
+    if (data == nullptr || (self <= data && data < self + sizeof(C))) return;
+    // std::string needs its NUL.
+    AddAllocation(container.capacity() * sizeof(*container.data()) +
+                  IsString(container));
+  }
+
+  // Count the backing array of an absl hash container: a slot and a control
+  // byte per element of capacity.
+  template <typename HashContainer>
+  void AddHashTable(const HashContainer& table) {
+    using value_type = typename HashContainer::value_type;
+    if (table.capacity() == 0) return;
+    AddAllocation(table.capacity() * (sizeof(value_type) + 1));
+  }
+
+  MemoryUsage& operator+=(const MemoryUsage& that) {
+    bytes += that.bytes;
+    allocations += that.allocations;
+    return *this;
+  }
+  MemoryUsage& operator-=(const MemoryUsage& that) {
+    bytes -= that.bytes;
+    allocations -= that.allocations;
+    return *this;
+  }
+
+ private:
+  static bool IsString(const std::string&) { return true; }
+  template <typename C>
+  static bool IsString(const C&) {
+    return false;
+  }
+};
+
+inline MemoryUsage operator+(MemoryUsage lhs, const MemoryUsage& rhs) {
+  return lhs += rhs;
+}
+inline MemoryUsage operator-(MemoryUsage lhs, const MemoryUsage& rhs) {
+  return lhs -= rhs;
+}
+inline bool operator==(const MemoryUsage& lhs, const MemoryUsage& rhs) {
+  return lhs.bytes == rhs.bytes && lhs.allocations == rhs.allocations;
+}
+inline bool operator!=(const MemoryUsage& lhs, const MemoryUsage& rhs) {
+  return !(lhs == rhs);
+}
+
+// The memory used by a parser spec, broken down by the kind of object.
+// Strings are interned and shared by all arguments, so they are only reported
+// as a whole.
+struct MemoryReport {
+  // The Argument objects, with their dest, type, action and nargs infos.
+  MemoryUsage arguments;
+  // The NamesInfo objects.
+  MemoryUsage names;
+  // The names, help docs and metavars copied into the string pool.
+  MemoryUsage strings;
+  // The const and default values held by Any. Only the Any itself is
+  // counted, not the memory the value owns (like the buffer of a string).
+  MemoryUsage values;
+  // The container, the ArgumentGroups and the bookkeeping of the holders.
+  MemoryUsage groups;
+  // The structures built by the backend, e.g., the argp options.
+  MemoryUsage backend;
+
+  // The memory of a group (or subcommand) and its arguments, with their names
+  // and values.
+  struct Entry {
+    std::string name;
+    MemoryUsage usage;
+  };
+  // One entry per ArgumentGroup, named by its title.
+  std::vector<Entry> per_group;
+  // One entry per SubCommand, named by its name.
+  std::vector<Entry> per_subcommand;
+
+  // The sum of all the kinds.
+  MemoryUsage GetTotal() const {
+    return arguments + names + strings + values + groups + backend;
+  }
+
+  // Add each kind of `that` to the same kind of this report. The entries are
+  // not copied.
+  void AddKinds(const MemoryReport& that);
+
+  // A multi-line human-readable form, for logs.
+  std::string DebugString() const;
+};
+
+}  // namespace internal
+}  // namespace argparse
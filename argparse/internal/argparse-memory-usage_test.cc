@@ -0,0 +1,93 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "argparse/internal/argparse-memory-usage.h"
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "absl/container/inlined_vector.h"
+#include "argparse/argparse-builder.h"
+#include "argparse/internal/argparse-any.h"
+#include "argparse/internal/argparse-subcommand.h"
+#include "gtest/gtest.h"
+
+namespace argparse {
+namespace internal {
+namespace testing_internal {
+
+TEST(MemoryUsage, InlineBufferIsNotCounted) {
+  MemoryUsage usage;
+  absl::InlinedVector<int, 4> vec = {1, 2};
+  usage.AddBuffer(vec);
+  EXPECT_EQ(usage, MemoryUsage());
+
+  vec.resize(5);
+  usage.AddBuffer(vec);
+  EXPECT_EQ(usage.bytes, vec.capacity() * sizeof(int));
+  EXPECT_EQ(usage.allocations, 1);
+}
+
+TEST(MemoryUsage, StringCountsNul) {
+  MemoryUsage usage;
+  std::string str(100, 'a');
+  usage.AddBuffer(str);
+  EXPECT_EQ(usage.bytes, str.capacity() + 1);
+  EXPECT_EQ(usage.allocations, 1);
+}
+
+TEST(MemoryUsage, AnyHeapSize) {
+  EXPECT_EQ(MakeAny<int>(1).GetHeapSize(), 0);
+  EXPECT_EQ(Any().GetHeapSize(), 0);
+  using Big = std::array<char, 4 * Any::kInlineSize>;
+  EXPECT_EQ(MakeAny<Big>().GetHeapSize(), sizeof(Big));
+}
+
+TEST(MemoryReport, CountsEachPartOfTheSpec) {
+  constexpr int kCount = 100;
+  std::vector<int> dests(kCount);
+  argparse::ArgumentParser parser;
+  for (int i = 0; i < kCount; ++i) {
+    parser.AddArgument(argparse::Argument("--flag-" + std::to_string(i),
+                                          &dests[i])
+                           .Help("help"));
+  }
+
+  auto report = parser.GetMemoryReport();
+  // Argument, DestInfo, ActionInfo and TypeInfo.
+  EXPECT_GE(report.arguments.allocations, 4 * kCount);
+  EXPECT_EQ(report.names.allocations, kCount);
+  EXPECT_GT(report.strings.bytes, 0);
+  EXPECT_GT(report.groups.bytes, 0);
+  EXPECT_GT(report.backend.bytes, 0);
+
+  ASSERT_EQ(report.per_group.size(), 2);
+  EXPECT_EQ(report.per_group[1].name, "optional arguments:");
+  auto per_arg = report.arguments + report.names + report.values;
+  EXPECT_GT(report.per_group[1].usage.bytes, per_arg.bytes);
+  EXPECT_TRUE(report.per_subcommand.empty());
+
+  auto total = report.GetTotal();
+  EXPECT_EQ(total.bytes, report.arguments.bytes + report.names.bytes +
+                             report.strings.bytes + report.values.bytes +
+                             report.groups.bytes + report.backend.bytes);
+  EXPECT_NE(report.DebugString().find("total"), std::string::npos);
+}
+
+TEST(MemoryReport, SubCommandHasItsOwnEntry) {
+  auto cmd = SubCommand::Create("run");
+  MemoryReport report;
+  cmd->AddMemoryUsage(&report);
+  ASSERT_EQ(report.per_subcommand.size(), 1);
+  EXPECT_EQ(report.per_subcommand[0].name, "run");
+  EXPECT_EQ(report.per_subcommand[0].usage, report.GetTotal());
+  // Its groups don't mix with the groups of the main holder.
+  EXPECT_TRUE(report.per_group.empty());
+}
+
+}  // namespace testing_internal
+}  // namespace internal
+}  // namespace argparse
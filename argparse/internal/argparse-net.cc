@@ -0,0 +1,278 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "argparse/internal/argparse-net.h"
+
+#include <algorithm>
+
+#include "absl/strings/str_cat.h"
+
+namespace argparse {
+namespace internal {
+namespace {
+
+int HexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+// Take a decimal number up to `max`, without leading 0, from the front of
+// `*p`, which is before `end`.
+bool ConsumeDecimal(const char** p, const char* end, unsigned max,
+                    unsigned* out) {
+  const char* begin = *p;
+  unsigned value = 0;
+  for (; *p != end && static_cast<unsigned char>(**p - '0') <= 9; ++*p) {
+    value = value * 10 + static_cast<unsigned>(**p - '0');
+    if (value > max) return false;
+  }
+  if (*p == begin || (*begin == '0' && *p - begin > 1)) return false;
+  *out = value;
+  return true;
+}
+
+bool ParseV4(const char* p, const char* end, std::uint32_t* out) {
+  std::uint32_t value = 0;
+  for (int i = 0; i < 4; ++i) {
+    if (i && (p == end || *p++ != '.')) return false;
+    unsigned part;
+    if (!ConsumeDecimal(&p, end, 255, &part)) return false;
+    value = value << 8 | part;
+  }
+  if (p != end) return false;
+  *out = value;
+  return true;
+}
+
+// Parse the 8 groups of an IPv6 address into `groups`.
+bool ParseV6(const char* p, const char* end, std::uint16_t* groups) {
+  int count = 0;
+  // Where "::" is among the groups, or -1.
+  int gap = -1;
+  if (end - p >= 2 && p[0] == ':' && p[1] == ':') {
+    gap = 0;
+    p += 2;
+  }
+  while (p != end) {
+    const char* q = p;
+    unsigned group = 0;
+    // One more than a group may have, to tell it is too long.
+    for (int digits = 0; q != end && digits < 5 && HexValue(*q) >= 0;
+         ++digits, ++q)
+      group = group << 4 | static_cast<unsigned>(HexValue(*q));
+    if (q != end && *q == '.') {
+      // A dotted quad for the last 2 groups.
+      std::uint32_t v4;
+      if (count > 6 || !ParseV4(p, end, &v4)) return false;
+      groups[count++] = static_cast<std::uint16_t>(v4 >> 16);
+      groups[count++] = static_cast<std::uint16_t>(v4);
+      break;
+    }
+    if (q == p || q - p > 4 || count == 8) return false;
+    groups[count++] = static_cast<std::uint16_t>(group);
+    p = q;
+    if (p == end) break;
+    // A ':' must be followed by another group, or by a second ':'.
+    if (*p++ != ':' || p == end) return false;
+    if (*p == ':') {
+      if (gap >= 0) return false;
+      gap = count;
+      ++p;
+    }
+  }
+  if (gap < 0) return count == 8;
+  // "::" stands for at least one group of 0.
+  if (count == 8) return false;
+  std::copy_backward(groups + gap, groups + count, groups + 8);
+  std::fill(groups + gap, groups + gap + 8 - count, 0);
+  return true;
+}
+
+// The mask of the first `length` bits of 128, in two halves.
+std::uint64_t HighMask(int length) {
+  return length >= 64 ? ~std::uint64_t{0}
+                      : length == 0 ? 0 : ~std::uint64_t{0} << (64 - length);
+}
+std::uint64_t LowMask(int length) {
+  return length > 64 ? HighMask(length - 64) : 0;
+}
+
+// The first block in `prefixes` that starts after `address`.
+template <typename Iterator>
+Iterator UpperBound(Iterator first, Iterator last, IpAddress address) {
+  return std::upper_bound(first, last, address,
+                          [](IpAddress a, const IpPrefix& prefix) {
+                            return a < prefix.GetAddress();
+                          });
+}
+
+}  // namespace
+
+bool IpAddress::Parse(absl::string_view str, IpAddress* out) {
+  const char* p = str.data();
+  const char* end = p + str.size();
+  if (std::find(p, end, ':') == end) {
+    std::uint32_t v4;
+    if (!ParseV4(p, end, &v4)) return false;
+    *out = FromV4(v4);
+    return true;
+  }
+  std::uint16_t groups[8];
+  if (!ParseV6(p, end, groups)) return false;
+  std::uint64_t halves[2] = {0, 0};
+  for (int i = 0; i < 8; ++i) halves[i / 4] = halves[i / 4] << 16 | groups[i];
+  *out = IpAddress(halves[0], halves[1]);
+  return true;
+}
+
+std::string IpAddress::Format() const {
+  if (IsV4()) {
+    auto v4 = GetV4();
+    return absl::StrCat(v4 >> 24, ".", (v4 >> 16) & 0xFF, ".",
+                        (v4 >> 8) & 0xFF, ".", v4 & 0xFF);
+  }
+  std::uint16_t groups[8];
+  for (int i = 0; i < 8; ++i) {
+    auto half = i < 4 ? high_ : low_;
+    groups[i] = static_cast<std::uint16_t>(half >> (16 * (3 - i % 4)));
+  }
+  // The first longest run of 2 or more groups of 0 becomes "::".
+  int gap = -1, gap_size = 1;
+  for (int i = 0; i < 8;) {
+    int j = i;
+    while (j < 8 && groups[j] == 0) ++j;
+    if (j - i > gap_size) {
+      gap = i;
+      gap_size = j - i;
+    }
+    i = j == i ? i + 1 : j;
+  }
+  std::string out;
+  for (int i = 0; i < 8; ++i) {
+    if (i == gap) {
+      out += "::";
+      i += gap_size - 1;
+      continue;
+    }
+    if (!out.empty() && out.back() != ':') out.push_back(':');
+    absl::StrAppend(&out, absl::Hex(groups[i]));
+  }
+  return out;
+}
+
+bool HostPort::Parse(absl::string_view str, HostPort* out) {
+  absl::string_view host;
+  std::size_t colon;
+  if (!str.empty() && str.front() == '[') {
+    auto close = str.find(']');
+    if (close == absl::string_view::npos) return false;
+    host = str.substr(1, close - 1);
+    // Brackets are only for IPv6.
+    if (host.find(':') == absl::string_view::npos) return false;
+    colon = close + 1;
+    if (colon == str.size() || str[colon] != ':') return false;
+  } else {
+    colon = str.find(':');
+    if (colon == absl::string_view::npos) return false;
+    host = str.substr(0, colon);
+    // Otherwise IPv6 would be ambiguous.
+    if (host.find(':') != absl::string_view::npos) return false;
+  }
+  IpAddress address;
+  if (!IpAddress::Parse(host, &address)) return false;
+  const char* p = str.data() + colon + 1;
+  const char* end = str.data() + str.size();
+  unsigned port;
+  if (!ConsumeDecimal(&p, end, 65535, &port) || p != end) return false;
+  out->address = address;
+  out->port = static_cast<std::uint16_t>(port);
+  return true;
+}
+
+std::string HostPort::Format() const {
+  if (address.IsV4()) return absl::StrCat(address.Format(), ":", port);
+  return absl::StrCat("[", address.Format(), "]:", port);
+}
+
+bool IpPrefix::Contains(IpAddress address) const {
+  return ((address.GetHigh() ^ address_.GetHigh()) & HighMask(length_)) ==
+             0 &&
+         ((address.GetLow() ^ address_.GetLow()) & LowMask(length_)) == 0;
+}
+
+bool IpPrefix::Parse(absl::string_view str, IpPrefix* out) {
+  auto slash = str.find('/');
+  if (slash == absl::string_view::npos) return false;
+  auto host = str.substr(0, slash);
+  IpAddress address;
+  if (!IpAddress::Parse(host, &address)) return false;
+  // By the text, not the address: "::ffff:0:0/96" is an IPv6 block.
+  bool v4 = host.find(':') == absl::string_view::npos;
+  const char* p = str.data() + slash + 1;
+  const char* end = str.data() + str.size();
+  unsigned length;
+  if (!ConsumeDecimal(&p, end, v4 ? 32 : 128, &length) || p != end)
+    return false;
+  if (v4) length += 96;
+  auto bits = static_cast<int>(length);
+  if ((address.GetHigh() & ~HighMask(bits)) ||
+      (address.GetLow() & ~LowMask(bits)))
+    return false;
+  out->address_ = address;
+  out->length_ = bits;
+  out->v4_ = v4;
+  return true;
+}
+
+std::string IpPrefix::Format() const {
+  // A mapped address in an IPv6 block keeps its IPv6 form, as in RFC 5952.
+  if (!v4_ && address_.IsV4())
+    return absl::StrCat("::ffff:", address_.Format(), "/", GetLength());
+  return absl::StrCat(address_.Format(), "/", GetLength());
+}
+
+void IpPrefixTable::Insert(const IpPrefix& prefix) {
+  // A block that starts at or after the last one goes at the end.
+  auto first = !prefixes_.empty() &&
+                       prefix.GetAddress() < prefixes_.back().GetAddress()
+                   ? UpperBound(prefixes_.begin(), prefixes_.end(),
+                                prefix.GetAddress())
+                   : prefixes_.end();
+  if (first != prefixes_.begin()) {
+    auto& prev = *(first - 1);
+    if (prev.Contains(prefix)) return;
+    // The same address with a shorter length.
+    if (prefix.Contains(prev)) --first;
+  }
+  // The blocks inside `prefix` follow it.
+  auto last = first;
+  while (last != prefixes_.end() && prefix.Contains(*last)) ++last;
+  if (first == last) {
+    prefixes_.insert(first, prefix);
+    return;
+  }
+  *first = prefix;
+  prefixes_.erase(first + 1, last);
+}
+
+bool IpPrefixTable::Contains(IpAddress address) const {
+  // Only the block before may hold it, as they are disjoint.
+  auto iter = UpperBound(prefixes_.begin(), prefixes_.end(), address);
+  return iter != prefixes_.begin() && (iter - 1)->Contains(address);
+}
+
+std::string IpPrefixTable::Format() const {
+  std::string out;
+  for (const auto& prefix : prefixes_) {
+    if (!out.empty()) out.push_back(',');
+    out += prefix.Format();
+  }
+  return out;
+}
+
+}  // namespace internal
+}  // namespace argparse
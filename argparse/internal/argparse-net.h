@@ -0,0 +1,150 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+
+// Network addresses in binary: "10.0.0.1", "[::1]:8080" and "10.0.0.0/8".
+namespace argparse {
+namespace internal {
+
+// An IPv4 or IPv6 address as a 128-bit integer. IPv4 is kept mapped into
+// IPv6 (::ffff:a.b.c.d), so the two compare as integers the same way, and
+// "::ffff:10.0.0.1" is the same address as "10.0.0.1".
+class IpAddress {
+ public:
+  // "::".
+  IpAddress() = default;
+  constexpr IpAddress(std::uint64_t high, std::uint64_t low)
+      : high_(high), low_(low) {}
+  static constexpr IpAddress FromV4(std::uint32_t v4) {
+    return IpAddress(0, kV4Mapped | v4);
+  }
+
+  // The upper and lower 64 bits, in host order.
+  std::uint64_t GetHigh() const { return high_; }
+  std::uint64_t GetLow() const { return low_; }
+  bool IsV4() const { return high_ == 0 && (low_ >> 32) == 0xFFFF; }
+  // The IPv4 address in host order, if IsV4().
+  std::uint32_t GetV4() const { return static_cast<std::uint32_t>(low_); }
+
+  // Parse a dotted quad, like "10.0.0.1", or IPv6 text of RFC 4291, like
+  // "2001:db8::1" or "::ffff:10.0.0.1". Parts of a dotted quad have no
+  // leading 0, so "010.0.0.1" is not taken. There is no zone, like "%eth0".
+  // Nothing is allocated.
+  static bool Parse(absl::string_view str, IpAddress* out);
+
+  // A dotted quad if IsV4(), otherwise IPv6 text of RFC 5952.
+  std::string Format() const;
+
+ private:
+  static constexpr std::uint64_t kV4Mapped = 0xFFFF00000000;
+
+  std::uint64_t high_ = 0;
+  std::uint64_t low_ = 0;
+};
+
+inline bool operator==(IpAddress lhs, IpAddress rhs) {
+  return lhs.GetHigh() == rhs.GetHigh() && lhs.GetLow() == rhs.GetLow();
+}
+inline bool operator!=(IpAddress lhs, IpAddress rhs) { return !(lhs == rhs); }
+inline bool operator<(IpAddress lhs, IpAddress rhs) {
+  return lhs.GetHigh() != rhs.GetHigh() ? lhs.GetHigh() < rhs.GetHigh()
+                                        : lhs.GetLow() < rhs.GetLow();
+}
+
+// An IP address and a port, like "10.0.0.1:80" or "[::1]:8080". The host is
+// numeric: a name would need a resolver.
+struct HostPort {
+  IpAddress address;
+  std::uint16_t port = 0;
+
+  // An IPv6 address must be in brackets. The port is decimal, up to 65535,
+  // without leading 0.
+  static bool Parse(absl::string_view str, HostPort* out);
+  std::string Format() const;
+};
+
+inline bool operator==(const HostPort& lhs, const HostPort& rhs) {
+  return lhs.address == rhs.address && lhs.port == rhs.port;
+}
+inline bool operator!=(const HostPort& lhs, const HostPort& rhs) {
+  return !(lhs == rhs);
+}
+
+// A CIDR block, like "10.0.0.0/8" or "2001:db8::/32".
+class IpPrefix {
+ public:
+  // "::/0".
+  IpPrefix() = default;
+
+  // The first address of the block.
+  IpAddress GetAddress() const { return address_; }
+  // The length in bits, out of 32 for IPv4 and 128 for IPv6.
+  int GetLength() const { return v4_ ? length_ - 96 : length_; }
+  // Whether it was written as IPv4. "::ffff:0:0/96" is IPv6, though its
+  // address is mapped IPv4.
+  bool IsV4() const { return v4_; }
+  bool Contains(IpAddress address) const;
+  // Whether `that` is inside this block.
+  bool Contains(const IpPrefix& that) const {
+    return length_ <= that.length_ && Contains(that.address_);
+  }
+
+  // Parse an address and a decimal length, separated by '/'. The length is
+  // out of 32 if the address is a dotted quad, otherwise out of 128. The bits
+  // of the address past the length must be 0, so "10.0.0.1/8" is not taken.
+  static bool Parse(absl::string_view str, IpPrefix* out);
+  std::string Format() const;
+
+ private:
+  IpAddress address_;
+  // Out of 128, even for IPv4.
+  int length_ = 0;
+  bool v4_ = false;
+};
+
+inline bool operator==(const IpPrefix& lhs, const IpPrefix& rhs) {
+  return lhs.GetAddress() == rhs.GetAddress() &&
+         lhs.GetLength() == rhs.GetLength() && lhs.IsV4() == rhs.IsV4();
+}
+inline bool operator!=(const IpPrefix& lhs, const IpPrefix& rhs) {
+  return !(lhs == rhs);
+}
+
+// A set of CIDR blocks kept sorted and disjoint, so a lookup is a binary
+// search. A block inside another one is dropped when it is inserted. This can
+// be an append dest, e.g., of --allow=10.0.0.0/8.
+class IpPrefixTable {
+ public:
+  using value_type = IpPrefix;
+
+  IpPrefixTable() = default;
+
+  // Inserting in address order is amortized O(1), as a block that goes last
+  // skips the binary search. Otherwise it is O(log n) plus the move of the
+  // blocks after it.
+  void Insert(const IpPrefix& prefix);
+  bool Contains(IpAddress address) const;
+
+  // Sorted by address.
+  const std::vector<IpPrefix>& GetPrefixes() const { return prefixes_; }
+  std::size_t size() const { return prefixes_.size(); }
+  bool empty() const { return prefixes_.empty(); }
+
+  // The blocks, separated by ','.
+  std::string Format() const;
+
+ private:
+  std::vector<IpPrefix> prefixes_;
+};
+
+}  // namespace internal
+}  // namespace argparse
@@ -0,0 +1,194 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "argparse/internal/argparse-net.h"
+
+#include "argparse/argparse-builder.h"
+#include "argparse/internal/argparse-parse-traits.h"
+#include "gtest/gtest.h"
+
+namespace argparse {
+namespace internal {
+namespace testing_internal {
+
+TEST(IpAddress, ParseV4) {
+  IpAddress address;
+  EXPECT_TRUE(Parse("10.0.0.1", &address));
+  EXPECT_TRUE(address.IsV4());
+  EXPECT_EQ(address.GetV4(), 0x0A000001u);
+  EXPECT_EQ(address, IpAddress::FromV4(0x0A000001));
+  EXPECT_TRUE(Parse("255.255.255.255", &address));
+  EXPECT_EQ(address.GetV4(), 0xFFFFFFFFu);
+  EXPECT_TRUE(Parse("0.0.0.0", &address));
+  EXPECT_TRUE(address.IsV4());
+
+  for (const char* bad :
+       {"", "10.0.0", "10.0.0.1.", "10.0.0.256", "010.0.0.1", "10..0.1",
+        "1.2.3.4 ", "+1.2.3.4", "1.2.3.0x4", "1000.0.0.1"})
+    EXPECT_FALSE(Parse(bad, &address)) << bad;
+}
+
+TEST(IpAddress, ParseV6) {
+  IpAddress address;
+  EXPECT_TRUE(Parse("2001:db8::1", &address));
+  EXPECT_EQ(address, IpAddress(0x20010DB800000000, 1));
+  EXPECT_TRUE(Parse("::", &address));
+  EXPECT_EQ(address, IpAddress());
+  EXPECT_TRUE(Parse("::1", &address));
+  EXPECT_EQ(address, IpAddress(0, 1));
+  EXPECT_TRUE(Parse("1::", &address));
+  EXPECT_EQ(address, IpAddress(0x0001000000000000, 0));
+  EXPECT_TRUE(Parse("1:2:3:4:5:6:7:8", &address));
+  EXPECT_EQ(address, IpAddress(0x0001000200030004, 0x0005000600070008));
+  EXPECT_TRUE(Parse("FFFF:ffff::1:2:3:4", &address));
+  EXPECT_EQ(address, IpAddress(0xFFFFFFFF00000000, 0x0001000200030004));
+  EXPECT_TRUE(Parse("64:ff9b::192.0.2.33", &address));
+  EXPECT_EQ(address, IpAddress(0x0064FF9B00000000, 0xC0000221));
+  // Mapped IPv4 is IPv4.
+  EXPECT_TRUE(Parse("::ffff:10.0.0.1", &address));
+  EXPECT_EQ(address, IpAddress::FromV4(0x0A000001));
+
+  for (const char* bad :
+       {":", ":::", "1:2", "1::2::3", ":1::", "1::2:", "1:2:3:4:5:6:7:8:9",
+        "1:2:3:4:5:6:7::8", "12345::", "::g", "fe80::1%eth0",
+        "1:2:3:4:5:6:7:1.2.3.4", "::1.2.3", "[::1]"})
+    EXPECT_FALSE(Parse(bad, &address)) << bad;
+}
+
+TEST(IpAddress, Format) {
+  const char* kCanonical[] = {
+      "10.0.0.1",    "::",          "::1",         "1::",
+      "2001:db8::1", "1:0:0:1::1",  "1::1:0:0:1",  "1:2:3:4:5:6:7:8",
+      "1:0:2:3:4:5:6:7",            "64:ff9b::c000:221",
+  };
+  for (const char* text : kCanonical) {
+    IpAddress address;
+    ASSERT_TRUE(Parse(text, &address)) << text;
+    EXPECT_EQ(address.Format(), text);
+  }
+  IpAddress address;
+  ASSERT_TRUE(Parse("2001:0DB8:0:0:0:0:0:0001", &address));
+  EXPECT_EQ(FormatValue(address), "2001:db8::1");
+  EXPECT_EQ(TypeHint<IpAddress>(), "address");
+}
+
+TEST(HostPort, Parse) {
+  HostPort host_port;
+  EXPECT_TRUE(Parse("10.0.0.1:80", &host_port));
+  EXPECT_EQ(host_port.address, IpAddress::FromV4(0x0A000001));
+  EXPECT_EQ(host_port.port, 80);
+  EXPECT_TRUE(Parse("[::1]:8080", &host_port));
+  EXPECT_EQ(host_port.address, IpAddress(0, 1));
+  EXPECT_EQ(host_port.port, 8080);
+  EXPECT_EQ(FormatValue(host_port), "[::1]:8080");
+  EXPECT_TRUE(Parse("0.0.0.0:65535", &host_port));
+  EXPECT_EQ(FormatValue(host_port), "0.0.0.0:65535");
+  EXPECT_EQ(TypeHint<HostPort>(), "host:port");
+
+  for (const char* bad :
+       {"10.0.0.1", "10.0.0.1:", "10.0.0.1:65536", "10.0.0.1:080",
+        "::1:80", "[::1]", "[::1]80", "[10.0.0.1]:80", "[::1:80",
+        "localhost:80", ":80"})
+    EXPECT_FALSE(Parse(bad, &host_port)) << bad;
+}
+
+TEST(IpPrefix, Parse) {
+  IpPrefix prefix;
+  EXPECT_TRUE(Parse("10.0.0.0/8", &prefix));
+  EXPECT_TRUE(prefix.IsV4());
+  EXPECT_EQ(prefix.GetLength(), 8);
+  EXPECT_EQ(prefix.GetAddress(), IpAddress::FromV4(0x0A000000));
+  EXPECT_TRUE(prefix.Contains(IpAddress::FromV4(0x0AFFFFFF)));
+  EXPECT_FALSE(prefix.Contains(IpAddress::FromV4(0x0B000000)));
+  EXPECT_EQ(FormatValue(prefix), "10.0.0.0/8");
+
+  EXPECT_TRUE(Parse("2001:db8::/32", &prefix));
+  EXPECT_FALSE(prefix.IsV4());
+  EXPECT_EQ(prefix.GetLength(), 32);
+  EXPECT_TRUE(prefix.Contains(IpAddress(0x20010DB8FFFFFFFF, 1)));
+  EXPECT_FALSE(prefix.Contains(IpAddress(0x20010DB900000000, 0)));
+
+  EXPECT_TRUE(Parse("0.0.0.0/0", &prefix));
+  EXPECT_TRUE(prefix.Contains(IpAddress::FromV4(0x01020304)));
+  EXPECT_FALSE(prefix.Contains(IpAddress(0, 1)));
+  EXPECT_TRUE(Parse("::/0", &prefix));
+  EXPECT_TRUE(prefix.Contains(IpAddress(~0ULL, ~0ULL)));
+  EXPECT_TRUE(Parse("1.2.3.4/32", &prefix));
+  EXPECT_TRUE(Parse("::1/128", &prefix));
+  EXPECT_EQ(TypeHint<IpPrefix>(), "cidr");
+
+  // The family is the one written, even for mapped addresses.
+  EXPECT_TRUE(Parse("::ffff:0:0/96", &prefix));
+  EXPECT_FALSE(prefix.IsV4());
+  EXPECT_EQ(prefix.GetLength(), 96);
+  EXPECT_TRUE(prefix.Contains(IpAddress::FromV4(0x01020304)));
+  EXPECT_EQ(FormatValue(prefix), "::ffff:0.0.0.0/96");
+  EXPECT_TRUE(Parse(FormatValue(prefix), &prefix));
+  EXPECT_EQ(prefix.GetLength(), 96);
+  EXPECT_TRUE(Parse("::ffff:10.0.0.0/104", &prefix));
+  EXPECT_FALSE(prefix.IsV4());
+  EXPECT_EQ(prefix.GetLength(), 104);
+  IpPrefix v4;
+  EXPECT_TRUE(Parse("10.0.0.0/8", &v4));
+  EXPECT_FALSE(prefix == v4);
+
+  for (const char* bad :
+       {"10.0.0.0", "10.0.0.0/", "10.0.0.0/33", "10.0.0.1/8", "10.0.0.0/08",
+        "::1/127", "::/129", "/8", "10.0.0.0/8/8"})
+    EXPECT_FALSE(Parse(bad, &prefix)) << bad;
+}
+
+IpPrefix MakePrefix(absl::string_view str) {
+  IpPrefix prefix;
+  EXPECT_TRUE(IpPrefix::Parse(str, &prefix)) << str;
+  return prefix;
+}
+
+IpAddress MakeAddress(absl::string_view str) {
+  IpAddress address;
+  EXPECT_TRUE(IpAddress::Parse(str, &address)) << str;
+  return address;
+}
+
+TEST(IpPrefixTable, Insert) {
+  IpPrefixTable table;
+  EXPECT_TRUE(table.empty());
+  EXPECT_FALSE(table.Contains(MakeAddress("10.0.0.1")));
+
+  for (const char* str : {"192.168.0.0/16", "10.1.0.0/16", "2001:db8::/32",
+                          "10.2.0.0/16", "172.16.0.0/12"})
+    table.Insert(MakePrefix(str));
+  EXPECT_EQ(table.Format(),
+            "10.1.0.0/16,10.2.0.0/16,172.16.0.0/12,192.168.0.0/16,"
+            "2001:db8::/32");
+
+  // Inside a block already.
+  table.Insert(MakePrefix("10.1.2.0/24"));
+  EXPECT_EQ(table.size(), 5);
+  // Covers two blocks, which are dropped.
+  table.Insert(MakePrefix("10.0.0.0/8"));
+  EXPECT_EQ(table.Format(),
+            "10.0.0.0/8,172.16.0.0/12,192.168.0.0/16,2001:db8::/32");
+  // The same address, a shorter length.
+  table.Insert(MakePrefix("192.168.0.0/15"));
+  EXPECT_EQ(table.size(), 4);
+  EXPECT_EQ(table.GetPrefixes()[2], MakePrefix("192.168.0.0/15"));
+}
+
+TEST(IpPrefixTable, Contains) {
+  IpPrefixTable table;
+  for (const char* str : {"10.0.0.0/8", "192.168.1.0/24", "2001:db8::/32"})
+    table.Insert(MakePrefix(str));
+  for (const char* str : {"10.0.0.0", "10.255.255.255", "192.168.1.7",
+                          "2001:db8:1::1", "::ffff:10.1.2.3"})
+    EXPECT_TRUE(table.Contains(MakeAddress(str))) << str;
+  for (const char* str : {"9.255.255.255", "11.0.0.0", "192.168.2.1", "::",
+                          "2001:db9::", "::a00:1"})
+    EXPECT_FALSE(table.Contains(MakeAddress(str))) << str;
+}
+
+}  // namespace testing_internal
+}  // namespace internal
+}  // namespace argparse
@@ -5,22 +5,28 @@
 
 #pragma once
 
-#include <typeindex>
+#include <cstddef>
+#include <utility>
 
 #include "absl/meta/type_traits.h"
 #include "argparse/internal/argparse-logging.h"
+#include "argparse/internal/argparse-port.h"
 
 namespace argparse {
 namespace internal {
 
-//  A type-erased type-safe void* wrapper.
+//  A type-erased type-safe void* wrapper. It is two words: a TypeTag and the
+//  pointer.
 class OpaquePtr final {
  public:
   template <typename T>
-  explicit OpaquePtr(T* ptr) : type_(typeid(T)), ptr_(ptr) {
+  explicit OpaquePtr(T* ptr) : type_(TypeTag::Of<T>()), ptr_(ptr) {
     ARGPARSE_DCHECK(ptr);
   }
 
+  // For those that keep the type and pointer apart, such as DestInfo.
+  OpaquePtr(TypeTag type, void* ptr) : type_(type), ptr_(ptr) {}
+
   OpaquePtr() = default;
   OpaquePtr(std::nullptr_t) : OpaquePtr() {}
   OpaquePtr(const OpaquePtr&) = default;
@@ -35,7 +41,7 @@ class OpaquePtr final {
 
   template <typename T>
   T* Cast() const {
-    ARGPARSE_DCHECK(type() == typeid(T));
+    ARGPARSE_DCHECK(type() == TypeTag::Of<T>());
     return reinterpret_cast<T*>(raw_value());
   }
 
@@ -70,12 +76,12 @@ class OpaquePtr final {
 
   explicit operator bool() const { return !!raw_value(); }
 
-  std::type_index type() const { return type_; }
+  TypeTag type() const { return type_; }
   void* raw_value() const { return ptr_; }
 
  private:
   // The type of *ptr_.
-  std::type_index type_ = typeid(void);
+  TypeTag type_ = TypeTag::Of<void>();
   void* ptr_ = nullptr;
 };
 
@@ -14,7 +14,7 @@ namespace {
 TEST(OpaquePtr, DefaultCtorWorks) {
   OpaquePtr ptr;
   EXPECT_TRUE(!ptr);
-  EXPECT_TRUE(ptr.type() == typeid(void));
+  EXPECT_TRUE(ptr.type() == TypeTag::Of<void>());
   EXPECT_TRUE(ptr.raw_value() == nullptr);
 }
 
@@ -28,17 +28,29 @@ TEST(OpaquePtr, CanBeConvertedFromNullptr) {
 TEST(OpaquePtr, NullptrCtorWorks) {
   OpaquePtr ptr = nullptr;
   EXPECT_TRUE(!ptr);
-  EXPECT_TRUE(ptr.type() == typeid(void));
+  EXPECT_TRUE(ptr.type() == TypeTag::Of<void>());
   EXPECT_TRUE(ptr.raw_value() == nullptr);
 }
 
 TEST(OpaquePtr, TemplateCtorWorks) {
   int val = 0;
   OpaquePtr ptr(&val);
-  EXPECT_TRUE(ptr.type() == typeid(val));
+  EXPECT_TRUE(ptr.type() == TypeTag::Of<int>());
   EXPECT_TRUE(ptr.raw_value() == &val);
 }
 
+TEST(OpaquePtr, IsTwoWords) {
+  static_assert(sizeof(OpaquePtr) == 2 * sizeof(void*), "");
+  static_assert(sizeof(TypeTag) == sizeof(void*), "");
+}
+
+TEST(OpaquePtr, TypeTagIdentifiesType) {
+  EXPECT_TRUE(TypeTag::Of<int>() == TypeTag::Of<int>());
+  EXPECT_TRUE(TypeTag::Of<int>() == TypeTag::Of<const int>());
+  EXPECT_TRUE(TypeTag::Of<int>() != TypeTag::Of<unsigned>());
+  EXPECT_TRUE(TypeTag::Of<int>() != TypeTag::Of<int*>());
+}
+
 TEST(OpaquePtr, CastWorks) {
   int val = 0;
   OpaquePtr ptr(&val);
@@ -86,7 +98,7 @@ TEST(OpaquePtr, ResetWithPtr) {
   int val;
   ptr.Reset(&val);
   EXPECT_TRUE(ptr.raw_value() == &val);
-  EXPECT_TRUE(ptr.type() == typeid(val));
+  EXPECT_TRUE(ptr.type() == TypeTag::Of<int>());
 }
 
 TEST(OpaquePtr, Swap) {
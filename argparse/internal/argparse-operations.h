@@ -5,14 +5,20 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <map>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <tuple>
 
+#include "absl/functional/function_ref.h"
+#include "absl/strings/str_cat.h"
 #include "argparse/argparse-traits.h"
 #include "argparse/internal/argparse-any.h"
 #include "argparse/internal/argparse-opaque-ptr.h"
+#include "argparse/internal/argparse-parse-list.h"
 #include "argparse/internal/argparse-parse-traits.h"
 #include "argparse/internal/argparse-ops-result.h"
 
@@ -28,26 +34,91 @@ enum class OpsKind {
   kCount,
   kParse,
   kOpen,
+  kInsert,
+  kStoreElements,
   kMaxOpsKind,
 };
 
 const char* OpsToString(OpsKind ops);
 
+// Parse a string into the object `out` points to, or set `*errmsg`.
+using ParseFunction =
+    absl::FunctionRef<bool(absl::string_view, OpaquePtr, std::string*)>;
+
 // A handle to the function table.
 class Operations {
  public:
+  explicit Operations(TypeTag type) : type_(type) {}
+
+  // The type this table works on.
+  TypeTag GetTypeTag() const { return type_; }
+
   // For actions:
-  virtual void Store(OpaquePtr dest, std::unique_ptr<Any> data) = 0;
+  virtual void Store(OpaquePtr dest, Any data) = 0;
   virtual void StoreConst(OpaquePtr dest, const Any& data) = 0;
-  virtual void Append(OpaquePtr dest, std::unique_ptr<Any> data) = 0;
+  virtual void Append(OpaquePtr dest, Any data) = 0;
   virtual void AppendConst(OpaquePtr dest, const Any& data) = 0;
   virtual void Count(OpaquePtr dest) = 0;
+  // Split `in` on `delimiter`, parse each piece into a value-type with
+  // `parse` and append it to `dest`. Room is reserved for all the pieces up
+  // front. On failure, the pieces before the bad one stay in `dest`, and
+  // `*errmsg` tells the index of the bad one.
+  virtual bool AppendSplit(OpaquePtr dest, absl::string_view in,
+                           char delimiter, ParseFunction parse,
+                           std::string* errmsg) = 0;
+  // Like AppendSplit(), but with the value-type's own Parse(). A vector of
+  // numbers is filled in bulk, see AppendNumberList().
+  virtual bool AppendSplitDefault(OpaquePtr dest, absl::string_view in,
+                                  char delimiter, std::string* errmsg) = 0;
+  // Parse each of `values` into a value-type with `parse` and append it to
+  // `dest`, which grows once for all of them. On failure, the values before
+  // the bad one stay in `dest`, and `*bad_index` is set to its index.
+  virtual bool AppendEach(OpaquePtr dest,
+                          absl::Span<const absl::string_view> values,
+                          ParseFunction parse, std::size_t* bad_index,
+                          std::string* errmsg) = 0;
+  // Like AppendEach(), but with the value-type's own Parse(). A vector of
+  // numbers is filled in bulk on up to `max_threads` threads, see
+  // AppendNumbers().
+  virtual bool AppendEachDefault(OpaquePtr dest,
+                                 absl::Span<const absl::string_view> values,
+                                 std::size_t max_threads,
+                                 std::size_t* bad_index,
+                                 std::string* errmsg) = 0;
+  // Split `in` on `delimiter`, or not at all if it is '\0', and each piece,
+  // like "key=value", on its first '='. Parse the halves with the key and
+  // mapped types' own Parse() and insert them into `dest` under `policy`. On
+  // failure, the pieces before the bad one stay in `dest`.
+  virtual bool InsertSplit(OpaquePtr dest, absl::string_view in,
+                           char delimiter, DuplicateKey policy,
+                           std::string* errmsg) = 0;
+  // The number of elements of `dest` if T is a tuple, a pair or a
+  // fixed-capacity array, otherwise 0.
+  virtual std::size_t GetFixedSize(OpaquePtr dest) = 0;
+  // Parse values[i] right into element i of `dest`, which has values.size()
+  // elements, with the element's own Parse(). On failure, `*bad_index` is the
+  // index of the bad value, and the elements before it are already set.
+  virtual bool StoreElements(OpaquePtr dest,
+                             absl::Span<const absl::string_view> values,
+                             std::size_t* bad_index, std::string* errmsg) = 0;
+  // Like StoreElements(), but with the values in one, separated by
+  // `delimiter`.
+  virtual bool StoreElementsSplit(OpaquePtr dest, absl::string_view in,
+                                  char delimiter, std::string* errmsg) = 0;
   // For types:
   virtual void Parse(absl::string_view in, OpsResult* out) = 0;
+  // Like Parse(), but right into `out`, which points to a T. On failure,
+  // `*out` is unspecified and `*errmsg` is set.
+  virtual bool ParseInPlace(absl::string_view in, OpaquePtr out,
+                            std::string* errmsg) = 0;
   virtual void Open(absl::string_view in, absl::string_view mode,
                     OpsResult* out) = 0;
   virtual bool IsSupported(OpsKind ops) = 0;
   virtual absl::string_view GetTypeName() = 0;
+  // Return sizeof(T).
+  virtual std::size_t GetTypeSize() = 0;
+  // Whether a parsed T refers to the command line. See argparse::IsViewType.
+  virtual bool IsViewType() = 0;
   virtual std::string GetTypeHint() = 0;
   virtual const std::type_info& GetTypeInfo() = 0;
   virtual std::string FormatValue(const Any& val) = 0;
@@ -56,6 +127,9 @@ class Operations {
 
   template <typename T>
   static Operations* GetInstance();
+
+ private:
+  const TypeTag type_;
 };
 
 // Extracted the bool value from AppendTraits.
@@ -74,6 +148,58 @@ struct IsAppendConstSupportedImpl<T, true>
 template <typename T>
 struct IsAppendConstSupported : IsAppendConstSupportedImpl<T> {};
 
+// AppendSplit() and AppendEach() need a value-type to parse into.
+template <typename T, bool = IsAppendSupported<T>{}>
+struct IsAppendSplitSupported : std::false_type {};
+template <typename T>
+struct IsAppendSplitSupported<T, true>
+    : std::is_default_constructible<ValueTypeOf<T>> {};
+
+// Extracted the bool value from InsertTraits. Both halves must be parsed in
+// place.
+template <typename T, bool = bool(InsertTraits<T>::Run)>
+struct IsInsertSupportedImpl : std::false_type {};
+template <typename T>
+struct IsInsertSupportedImpl<T, true>
+    : std::integral_constant<
+          bool, std::is_default_constructible<KeyTypeOf<T>>{} &&
+                    std::is_default_constructible<MappedTypeOf<T>>{} &&
+                    IsParseDefined<KeyTypeOf<T>>{} &&
+                    IsParseDefined<MappedTypeOf<T>>{}> {};
+
+template <typename T>
+struct IsInsertSupported : IsInsertSupportedImpl<T> {};
+
+// Each element of a tuple is parsed in place.
+template <typename T, bool = IsTupleType<T>{}>
+struct IsStoreTupleSupported : std::false_type {};
+template <typename... Ts>
+struct IsStoreTupleSupported<std::tuple<Ts...>, true>
+    : absl::conjunction<IsParseDefined<Ts>...> {};
+template <typename A, typename B>
+struct IsStoreTupleSupported<std::pair<A, B>, true>
+    : absl::conjunction<IsParseDefined<A>, IsParseDefined<B>> {};
+
+// So is each element of a fixed-capacity array, which never grows.
+template <typename T, bool = IsFixedCapacity<T>{}>
+struct IsStoreArraySupported : std::false_type {};
+template <typename T>
+struct IsStoreArraySupported<T, true>
+    : IsParseDefined<typename T::value_type> {};
+
+// How StoreElements() gets to the elements of a T.
+enum class ElementsKind { kNone, kTuple, kArray };
+
+template <ElementsKind K>
+using ElementsTag = std::integral_constant<ElementsKind, K>;
+
+template <typename T>
+using ElementsKindOf =
+    ElementsTag<IsStoreTupleSupported<T>{}
+                    ? ElementsKind::kTuple
+                    : IsStoreArraySupported<T>{} ? ElementsKind::kArray
+                                                 : ElementsKind::kNone>;
+
 template <OpsKind Ops, typename T>
 struct IsOpsSupported : std::false_type {};
 
@@ -102,13 +228,20 @@ struct IsOpsSupported<OpsKind::kParse, T> : internal::IsParseDefined<T> {};
 template <typename T>
 struct IsOpsSupported<OpsKind::kOpen, T> : IsOpenDefined<T> {};
 
+template <typename T>
+struct IsOpsSupported<OpsKind::kInsert, T> : IsInsertSupported<T> {};
+
+template <typename T>
+struct IsOpsSupported<OpsKind::kStoreElements, T>
+    : absl::disjunction<IsStoreTupleSupported<T>, IsStoreArraySupported<T>> {};
+
 // Put the code used only in this module here.
 namespace operations_internal {
 
 template <typename T>
-ABSL_MUST_USE_RESULT T TakeValueAndDiscard(std::unique_ptr<Any> any) {
+ABSL_MUST_USE_RESULT T TakeValueAndDiscard(Any any) {
   ARGPARSE_INTERNAL_DCHECK(any, "");
-  return std::move_if_noexcept(AnyCast<T>(*any));
+  return std::move_if_noexcept(AnyCast<T>(any));
 }
 
 template <OpsKind Ops, typename T, bool = IsOpsSupported<Ops, T>{}>
@@ -122,7 +255,7 @@ struct OpsMethod<Ops, T, false> {
 
 template <typename T>
 struct OpsMethod<OpsKind::kStore, T, true> {
-  static void Run(OpaquePtr dest, std::unique_ptr<Any> data) {
+  static void Run(OpaquePtr dest, Any data) {
     if (data) dest.PutValue(TakeValueAndDiscard<T>(std::move(data)));
   }
 };
@@ -136,7 +269,7 @@ struct OpsMethod<OpsKind::kStoreConst, T, true> {
 
 template <typename T>
 struct OpsMethod<OpsKind::kAppend, T, true> {
-  static void Run(OpaquePtr dest, std::unique_ptr<Any> data) {
+  static void Run(OpaquePtr dest, Any data) {
     if (data) {
       auto* ptr = dest.Cast<T>();
       auto value = AnyCast<ValueTypeOf<T>>(std::move(data));
@@ -165,7 +298,21 @@ struct OpsMethod<OpsKind::kCount, T, true> {
 template <typename T>
 struct OpsMethod<OpsKind::kParse, T, true> {
   static void Run(absl::string_view in, OpsResult* out) {
-    //TODO:
+    T value;
+    if (internal::Parse(in, &value)) {
+      out->value = MakeAny<T>(std::move_if_noexcept(value));
+      return;
+    }
+    out->has_error = true;
+    out->errmsg = ErrorMessage();
+  }
+  static bool Run(absl::string_view in, OpaquePtr out, std::string* errmsg) {
+    if (internal::Parse(in, out.Cast<T>())) return true;
+    *errmsg = ErrorMessage();
+    return false;
+  }
+  static std::string ErrorMessage() {
+    return "invalid " + TypeHint<T>() + " value";
   }
 };
 
@@ -173,10 +320,260 @@ template <typename T>
 struct OpsMethod<OpsKind::kOpen, T, true> {
   static void Run(absl::string_view in, absl::string_view mode,
                   OpsResult* out) {
-    // TODO:
+    T file;
+    if (internal::Open(in, mode, &file)) {
+      out->value = MakeAny<T>(std::move(file));
+      return;
+    }
+    out->has_error = true;
+    out->errmsg = "cannot open file";
   }
 };
 
+// Make room for `n` more elements if T has reserve() and capacity(). The
+// capacity at least doubles, so repeated calls still take amortized O(1).
+template <typename T>
+auto ReserveMore(T* ptr, std::size_t n, int)
+    -> decltype(ptr->reserve(ptr->capacity()), void()) {
+  auto size = ptr->size() + n;
+  if (size > ptr->capacity())
+    ptr->reserve(std::max<std::size_t>(size, 2 * ptr->capacity()));
+}
+template <typename T>
+void ReserveMore(T*, std::size_t, long) {}
+
+template <typename T>
+bool AppendSplitImpl(std::true_type, OpaquePtr dest, absl::string_view in,
+                     char delimiter, ParseFunction parse,
+                     std::string* errmsg) {
+  auto* ptr = dest.Cast<T>();
+  ReserveMore(ptr, 1 + CountChar(in, delimiter), 0);
+  for (std::size_t i = 0;; ++i) {
+    auto pos = in.find(delimiter);
+    ValueTypeOf<T> value;
+    if (!parse(in.substr(0, pos), OpaquePtr(&value), errmsg)) {
+      absl::StrAppend(errmsg, " at index ", i);
+      return false;
+    }
+    AppendTraits<T>::Run(ptr, std::move_if_noexcept(value));
+    if (pos == absl::string_view::npos) return true;
+    in.remove_prefix(pos + 1);
+  }
+}
+
+template <typename T>
+bool AppendSplitImpl(std::false_type, OpaquePtr, absl::string_view, char,
+                     ParseFunction, std::string*) {
+  return false;
+}
+
+template <typename T>
+bool AppendEachImpl(std::true_type, OpaquePtr dest,
+                    absl::Span<const absl::string_view> values,
+                    ParseFunction parse, std::size_t* bad_index,
+                    std::string* errmsg) {
+  auto* ptr = dest.Cast<T>();
+  ReserveMore(ptr, values.size(), 0);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    ValueTypeOf<T> value;
+    if (!parse(values[i], OpaquePtr(&value), errmsg)) {
+      *bad_index = i;
+      return false;
+    }
+    AppendTraits<T>::Run(ptr, std::move_if_noexcept(value));
+  }
+  return true;
+}
+
+template <typename T>
+bool AppendEachImpl(std::false_type, OpaquePtr,
+                    absl::Span<const absl::string_view>, ParseFunction,
+                    std::size_t*, std::string*) {
+  return false;
+}
+
+// Insert one "key=value" into `ptr`.
+template <typename T>
+bool InsertPiece(T* ptr, absl::string_view piece, DuplicateKey policy,
+                 std::string* errmsg) {
+  auto equal = piece.find('=');
+  if (equal == absl::string_view::npos) {
+    *errmsg = "expected key=value";
+    return false;
+  }
+  auto key_str = piece.substr(0, equal);
+  KeyTypeOf<T> key;
+  MappedTypeOf<T> value;
+  if (!OpsMethod<OpsKind::kParse, KeyTypeOf<T>>::Run(key_str, OpaquePtr(&key),
+                                                      errmsg) ||
+      !OpsMethod<OpsKind::kParse, MappedTypeOf<T>>::Run(
+          piece.substr(equal + 1), OpaquePtr(&value), errmsg))
+    return false;
+  if (InsertTraits<T>::Run(ptr, std::move(key), std::move(value), policy))
+    return true;
+  *errmsg = absl::StrCat("duplicate key '", key_str, "'");
+  return false;
+}
+
+template <typename T>
+bool InsertSplitImpl(std::true_type, OpaquePtr dest, absl::string_view in,
+                     char delimiter, DuplicateKey policy,
+                     std::string* errmsg) {
+  auto* ptr = dest.Cast<T>();
+  if (!delimiter) return InsertPiece(ptr, in, policy, errmsg);
+  for (std::size_t i = 0;; ++i) {
+    auto pos = in.find(delimiter);
+    if (!InsertPiece(ptr, in.substr(0, pos), policy, errmsg)) {
+      absl::StrAppend(errmsg, " at index ", i);
+      return false;
+    }
+    if (pos == absl::string_view::npos) return true;
+    in.remove_prefix(pos + 1);
+  }
+}
+
+template <typename T>
+bool InsertSplitImpl(std::false_type, OpaquePtr, absl::string_view, char,
+                     DuplicateKey, std::string*) {
+  return false;
+}
+
+template <std::size_t I, typename T>
+bool ParseTupleElement(absl::string_view in, T* ptr, std::size_t* bad_index,
+                       std::string* errmsg) {
+  using Element = typename std::tuple_element<I, T>::type;
+  if (OpsMethod<OpsKind::kParse, Element>::Run(
+          in, OpaquePtr(&std::get<I>(*ptr)), errmsg))
+    return true;
+  *bad_index = I;
+  return false;
+}
+
+template <typename T, std::size_t... I>
+bool ParseTupleElements(absl::Span<const absl::string_view> values, T* ptr,
+                        std::size_t* bad_index, std::string* errmsg,
+                        absl::index_sequence<I...>) {
+  bool ok = true;
+  // A braced list runs in order, and `ok &&` stops at the first failure.
+  (void)std::initializer_list<bool>{
+      (ok = ok && ParseTupleElement<I>(values[I], ptr, bad_index, errmsg))...};
+  return ok;
+}
+
+template <typename T>
+bool StoreElementsImpl(ElementsTag<ElementsKind::kTuple>, OpaquePtr dest,
+                       absl::Span<const absl::string_view> values,
+                       std::size_t* bad_index, std::string* errmsg) {
+  constexpr std::size_t kSize = std::tuple_size<T>::value;
+  ARGPARSE_INTERNAL_DCHECK(values.size() == kSize, "");
+  return ParseTupleElements(values, dest.Cast<T>(), bad_index, errmsg,
+                            absl::make_index_sequence<kSize>{});
+}
+
+template <typename T>
+bool StoreElementsImpl(ElementsTag<ElementsKind::kArray>, OpaquePtr dest,
+                       absl::Span<const absl::string_view> values,
+                       std::size_t* bad_index, std::string* errmsg) {
+  using Element = typename T::value_type;
+  auto& array = *dest.Cast<T>();
+  ARGPARSE_INTERNAL_DCHECK(!values.empty(), "");
+  // A Span can be bound to another buffer after the argument is built.
+  if (values.size() != array.size()) {
+    *errmsg = absl::StrCat("expected ", array.size(), " values, got ",
+                           values.size());
+    *bad_index = std::min(array.size(), values.size() - 1);
+    return false;
+  }
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    if (!OpsMethod<OpsKind::kParse, Element>::Run(
+            values[i], OpaquePtr(&array[i]), errmsg)) {
+      *bad_index = i;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool StoreElementsImpl(ElementsTag<ElementsKind::kNone>, OpaquePtr,
+                       absl::Span<const absl::string_view>, std::size_t*,
+                       std::string*) {
+  return false;
+}
+
+inline bool CheckElementCount(absl::string_view in, char delimiter,
+                              std::size_t size, std::string* errmsg) {
+  auto count = 1 + CountChar(in, delimiter);
+  if (count == size) return true;
+  *errmsg = absl::StrCat("expected ", size, " values, got ", count);
+  return false;
+}
+
+template <typename T>
+bool StoreElementsSplitImpl(ElementsTag<ElementsKind::kTuple>, OpaquePtr dest,
+                            absl::string_view in, char delimiter,
+                            std::string* errmsg) {
+  constexpr std::size_t kSize = std::tuple_size<T>::value;
+  if (!CheckElementCount(in, delimiter, kSize, errmsg)) return false;
+  // The pieces stay in the command line.
+  std::array<absl::string_view, kSize> pieces;
+  for (auto& piece : pieces) {
+    auto pos = in.find(delimiter);
+    piece = in.substr(0, pos);
+    in.remove_prefix(pos == absl::string_view::npos ? in.size() : pos + 1);
+  }
+  std::size_t bad_index;
+  if (StoreElementsImpl<T>(ElementsTag<ElementsKind::kTuple>{}, dest, pieces,
+                           &bad_index, errmsg))
+    return true;
+  absl::StrAppend(errmsg, " at index ", bad_index);
+  return false;
+}
+
+template <typename T>
+bool StoreElementsSplitImpl(ElementsTag<ElementsKind::kArray>, OpaquePtr dest,
+                            absl::string_view in, char delimiter,
+                            std::string* errmsg) {
+  using Element = typename T::value_type;
+  auto& array = *dest.Cast<T>();
+  if (!CheckElementCount(in, delimiter, array.size(), errmsg)) return false;
+  // Each piece goes right into its element as it is split off.
+  for (std::size_t i = 0; i < array.size(); ++i) {
+    auto pos = in.find(delimiter);
+    if (!OpsMethod<OpsKind::kParse, Element>::Run(
+            in.substr(0, pos), OpaquePtr(&array[i]), errmsg)) {
+      absl::StrAppend(errmsg, " at index ", i);
+      return false;
+    }
+    in.remove_prefix(pos == absl::string_view::npos ? in.size() : pos + 1);
+  }
+  return true;
+}
+
+template <typename T>
+bool StoreElementsSplitImpl(ElementsTag<ElementsKind::kNone>, OpaquePtr,
+                            absl::string_view, char, std::string*) {
+  return false;
+}
+
+// The size of a std::array is known at compile time, that of an
+// absl::FixedArray or absl::Span when the dest is given.
+template <typename T>
+std::size_t GetFixedSizeImpl(ElementsTag<ElementsKind::kTuple>, OpaquePtr) {
+  return std::tuple_size<T>::value;
+}
+
+template <typename T>
+std::size_t GetFixedSizeImpl(ElementsTag<ElementsKind::kArray>,
+                             OpaquePtr dest) {
+  return dest.Cast<T>()->size();
+}
+
+template <typename T>
+std::size_t GetFixedSizeImpl(ElementsTag<ElementsKind::kNone>, OpaquePtr) {
+  return 0;
+}
+
 template <typename T, std::size_t... OpsIndices>
 bool OpsIsSupportedImpl(OpsKind ops, absl::index_sequence<OpsIndices...>) {
   constexpr bool kFlagArray[] = {
@@ -187,13 +584,14 @@ bool OpsIsSupportedImpl(OpsKind ops, absl::index_sequence<OpsIndices...>) {
 template <typename T>
 class OperationsImpl final : public Operations {
  public:
-  void Store(OpaquePtr dest, std::unique_ptr<Any> data) override {
+  OperationsImpl() : Operations(TypeTag::Of<T>()) {}
+  void Store(OpaquePtr dest, Any data) override {
     return OpsMethod<OpsKind::kStore, T>::Run(dest, std::move(data));
   }
   void StoreConst(OpaquePtr dest, const Any& data) override {
     return OpsMethod<OpsKind::kStoreConst, T>::Run(dest, data);
   }
-  void Append(OpaquePtr dest, std::unique_ptr<Any> data) override {
+  void Append(OpaquePtr dest, Any data) override {
     return OpsMethod<OpsKind::kAppend, T>::Run(dest, std::move(data));
   }
   void AppendConst(OpaquePtr dest, const Any& data) override {
@@ -202,9 +600,56 @@ class OperationsImpl final : public Operations {
   void Count(OpaquePtr dest) override {
     return OpsMethod<OpsKind::kCount, T>::Run(dest);
   }
+  bool AppendSplit(OpaquePtr dest, absl::string_view in, char delimiter,
+                   ParseFunction parse, std::string* errmsg) override {
+    return AppendSplitImpl<T>(IsAppendSplitSupported<T>{}, dest, in,
+                              delimiter, parse, errmsg);
+  }
+  bool AppendSplitDefault(OpaquePtr dest, absl::string_view in,
+                          char delimiter, std::string* errmsg) override {
+    return AppendSplitDefaultImpl(IsNumberList<T>{}, dest, in, delimiter,
+                                  errmsg);
+  }
+  bool AppendEach(OpaquePtr dest, absl::Span<const absl::string_view> values,
+                  ParseFunction parse, std::size_t* bad_index,
+                  std::string* errmsg) override {
+    return AppendEachImpl<T>(IsAppendSplitSupported<T>{}, dest, values, parse,
+                             bad_index, errmsg);
+  }
+  bool AppendEachDefault(OpaquePtr dest,
+                         absl::Span<const absl::string_view> values,
+                         std::size_t max_threads, std::size_t* bad_index,
+                         std::string* errmsg) override {
+    return AppendEachDefaultImpl(IsNumberList<T>{}, dest, values, max_threads,
+                                 bad_index, errmsg);
+  }
+  bool InsertSplit(OpaquePtr dest, absl::string_view in, char delimiter,
+                   DuplicateKey policy, std::string* errmsg) override {
+    return InsertSplitImpl<T>(IsInsertSupported<T>{}, dest, in, delimiter,
+                              policy, errmsg);
+  }
+  std::size_t GetFixedSize(OpaquePtr dest) override {
+    return GetFixedSizeImpl<T>(ElementsKindOf<T>{}, dest);
+  }
+  bool StoreElements(OpaquePtr dest,
+                     absl::Span<const absl::string_view> values,
+                     std::size_t* bad_index, std::string* errmsg) override {
+    return StoreElementsImpl<T>(ElementsKindOf<T>{}, dest, values, bad_index,
+                                errmsg);
+  }
+  bool StoreElementsSplit(OpaquePtr dest, absl::string_view in, char delimiter,
+                          std::string* errmsg) override {
+    return StoreElementsSplitImpl<T>(ElementsKindOf<T>{}, dest, in, delimiter,
+                                     errmsg);
+  }
   void Parse(absl::string_view in, OpsResult* out) override {
     return OpsMethod<OpsKind::kParse, T>::Run(in, out);
   }
+  bool ParseInPlace(absl::string_view in, OpaquePtr out,
+                    std::string* errmsg) override {
+    return ParseInPlaceImpl(IsOpsSupported<OpsKind::kParse, T>{}, in, out,
+                            errmsg);
+  }
   void Open(absl::string_view in, absl::string_view mode,
             OpsResult* out) override {
     return OpsMethod<OpsKind::kOpen, T>::Run(in, mode, out);
@@ -214,6 +659,8 @@ class OperationsImpl final : public Operations {
         ops, absl::make_index_sequence<size_t(OpsKind::kMaxOpsKind)>{});
   }
   absl::string_view GetTypeName() override { return TypeName<T>(); }
+  std::size_t GetTypeSize() override { return sizeof(T); }
+  bool IsViewType() override { return argparse::IsViewType<T>::value; }
   std::string GetTypeHint() override { return TypeHintTraits<T>::Run(); }
   std::string FormatValue(const Any& val) override {
     return FormatTraits<T>::Run(AnyCast<T>(val));
@@ -221,6 +668,60 @@ class OperationsImpl final : public Operations {
   const std::type_info& GetTypeInfo() override { return typeid(T); }
   // See below.
   Operations* GetValueTypeOps() override;
+
+ private:
+  static bool ParseInPlaceImpl(std::true_type, absl::string_view in,
+                               OpaquePtr out, std::string* errmsg) {
+    return OpsMethod<OpsKind::kParse, T>::Run(in, out, errmsg);
+  }
+  static bool ParseInPlaceImpl(std::false_type, absl::string_view,
+                               OpaquePtr, std::string*) {
+    return false;
+  }
+  // The bulk path.
+  bool AppendSplitDefaultImpl(std::true_type, OpaquePtr dest,
+                              absl::string_view in, char delimiter,
+                              std::string* errmsg) {
+    std::size_t bad_index;
+    if (AppendNumberList(in, delimiter, dest.Cast<T>(), &bad_index))
+      return true;
+    *errmsg = absl::StrCat(
+        OpsMethod<OpsKind::kParse, ValueTypeOf<T>>::ErrorMessage(),
+        " at index ", bad_index);
+    return false;
+  }
+  bool AppendSplitDefaultImpl(std::false_type, OpaquePtr dest,
+                              absl::string_view in, char delimiter,
+                              std::string* errmsg) {
+    auto* ops = GetValueTypeOps();
+    if (!ops) return false;
+    auto parse = [ops](absl::string_view piece, OpaquePtr out,
+                       std::string* msg) {
+      return ops->ParseInPlace(piece, out, msg);
+    };
+    return AppendSplit(dest, in, delimiter, parse, errmsg);
+  }
+  bool AppendEachDefaultImpl(std::true_type, OpaquePtr dest,
+                             absl::Span<const absl::string_view> values,
+                             std::size_t max_threads, std::size_t* bad_index,
+                             std::string* errmsg) {
+    if (AppendNumbers(values, dest.Cast<T>(), bad_index, max_threads))
+      return true;
+    *errmsg = OpsMethod<OpsKind::kParse, ValueTypeOf<T>>::ErrorMessage();
+    return false;
+  }
+  bool AppendEachDefaultImpl(std::false_type, OpaquePtr dest,
+                             absl::Span<const absl::string_view> values,
+                             std::size_t, std::size_t* bad_index,
+                             std::string* errmsg) {
+    auto* ops = GetValueTypeOps();
+    if (!ops) return false;
+    auto parse = [ops](absl::string_view value, OpaquePtr out,
+                       std::string* msg) {
+      return ops->ParseInPlace(value, out, msg);
+    };
+    return AppendEach(dest, values, parse, bad_index, errmsg);
+  }
 };
 
 template <typename T>
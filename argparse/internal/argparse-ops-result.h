@@ -9,11 +9,11 @@
 namespace argparse {
 namespace internal {
 
-using StatusOrAny = absl::StatusOr<std::unique_ptr<Any>>;
+using StatusOrAny = absl::StatusOr<Any>;
 
 struct OpsResult {
   bool has_error = false;
-  std::unique_ptr<Any> value;  // null if error.
+  Any value;  // empty if error.
   std::string errmsg;
 
 };
@@ -4,6 +4,7 @@
 // https://opensource.org/licenses/MIT
 
 #include "absl/strings/ascii.h"
+#include "argparse/argparse-traits.h"
 #include "argparse/internal/argparse-logging.h"
 #include "argparse/internal/argparse-parse-traits.h"
 #include "gtest/gtest.h"
@@ -80,6 +81,16 @@ TYPED_TEST(ParseTest, PositiveCase) {
   }
 }
 
+TEST(ParseStringView, PointsIntoInput) {
+  const char kInput[] = "some/path";
+  absl::string_view view;
+  EXPECT_TRUE(internal::Parse(kInput, &view));
+  EXPECT_EQ(view.data(), kInput);
+  EXPECT_EQ(view.size(), sizeof(kInput) - 1);
+  EXPECT_TRUE(IsViewType<absl::string_view>::value);
+  EXPECT_FALSE(IsViewType<std::string>::value);
+}
+
 }  // namespace testing_internal
 }  // namespace internal
 }  // namespace argparse
@@ -0,0 +1,44 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "argparse/internal/argparse-parse-budget.h"
+
+#include "absl/strings/str_format.h"
+
+namespace argparse {
+namespace internal {
+
+absl::Status ParseBudgetTracker::Charge(absl::string_view what,
+                                        std::size_t limit, std::size_t amount,
+                                        std::size_t* used) {
+  if (!status_.ok()) return status_;
+  *used += amount;
+  if (limit && *used > limit) {
+    status_ = absl::ResourceExhaustedError(absl::StrFormat(
+        "parse budget exceeded: more than %d %s", limit, what));
+  }
+  return status_;
+}
+
+absl::Status ParseBudgetTracker::ChargeArgs(ArgArray args) {
+  auto status = Charge("tokens", budget_.max_tokens, args.GetArgc(), &tokens_);
+  // Stop at the first token beyond the limit.
+  for (std::size_t i = 0; status.ok() && i < args.size(); ++i)
+    status = ChargeBytes(args[i].size() + 1);
+  return status;
+}
+
+absl::Status ParseBudgetTracker::ChargeBytes(std::size_t bytes) {
+  return Charge("bytes", budget_.max_bytes, bytes, &bytes_);
+}
+
+absl::Status ParseBudgetTracker::ChargeValues(std::size_t count,
+                                              std::size_t bytes) {
+  auto status = Charge("values", budget_.max_values, count, &values_);
+  return status.ok() ? ChargeBytes(bytes) : status;
+}
+
+}  // namespace internal
+}  // namespace argparse
@@ -0,0 +1,74 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <cstddef>
+
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "argparse/internal/argparse-arg-array.h"
+
+namespace argparse {
+namespace internal {
+
+// Limits on what a single parse call may consume, for parsers that take argv
+// from less-trusted sources. Zero means no limit.
+struct ParseBudget {
+  // Bytes of the command line, of the values added to dests and of the
+  // scratch space (e.g., error messages) used by the parser.
+  std::size_t max_bytes = 0;
+  // Number of values appended to dests.
+  std::size_t max_values = 0;
+  // Number of tokens of the command line.
+  std::size_t max_tokens = 0;
+  // Threads used to convert a large batch of values, like those of a '*'
+  // positional, see AppendNumbers(). Unlike the limits above, it is 1 by
+  // default, which keeps the parse on the calling thread. 0 means
+  // hardware_concurrency().
+  std::size_t max_threads = 1;
+};
+
+// Keeps track of a ParseBudget during one parse call. Once a limit is
+// exceeded, every later charge fails with the same ResourceExhausted status,
+// so the parser can stop at the first chance.
+class ParseBudgetTracker final {
+ public:
+  explicit ParseBudgetTracker(const ParseBudget& budget) : budget_(budget) {}
+
+  // Charge for the tokens of the command line and their bytes.
+  absl::Status ChargeArgs(ArgArray args);
+
+  // Charge for `bytes` of memory taken by the parser or the dests.
+  absl::Status ChargeBytes(std::size_t bytes);
+
+  // Charge for a value of `bytes` appended to a dest.
+  absl::Status ChargeValue(std::size_t bytes) { return ChargeValues(1, bytes); }
+
+  // Charge for `count` values of `bytes` in total appended to a dest.
+  absl::Status ChargeValues(std::size_t count, std::size_t bytes);
+
+  // The first error, or OK.
+  const absl::Status& status() const { return status_; }
+
+  std::size_t GetBytesUsed() const { return bytes_; }
+  std::size_t GetValuesUsed() const { return values_; }
+  std::size_t GetTokensUsed() const { return tokens_; }
+  std::size_t GetMaxThreads() const { return budget_.max_threads; }
+
+ private:
+  // Add `amount` to `*used`. Fail if it goes beyond `limit` (non-zero).
+  absl::Status Charge(absl::string_view what, std::size_t limit,
+                      std::size_t amount, std::size_t* used);
+
+  const ParseBudget budget_;
+  std::size_t bytes_ = 0;
+  std::size_t values_ = 0;
+  std::size_t tokens_ = 0;
+  absl::Status status_;
+};
+
+}  // namespace internal
+}  // namespace argparse
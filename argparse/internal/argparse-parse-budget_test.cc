@@ -0,0 +1,116 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "argparse/internal/argparse-parse-budget.h"
+
+#include <string>
+#include <vector>
+
+#include "argparse/argparse-builder.h"
+#include "argparse/internal/argparse-argument-builder.h"
+#include "gtest/gtest.h"
+
+namespace argparse {
+namespace internal {
+namespace testing_internal {
+
+TEST(ParseBudgetTracker, UnlimitedByDefault) {
+  ParseBudgetTracker budget{ParseBudget()};
+  for (int i = 0; i < 1000; ++i) EXPECT_TRUE(budget.ChargeValue(1 << 20).ok());
+  EXPECT_EQ(budget.GetValuesUsed(), 1000);
+}
+
+TEST(ParseBudgetTracker, FirstErrorSticks) {
+  ParseBudget limits;
+  limits.max_bytes = 10;
+  ParseBudgetTracker budget(limits);
+  EXPECT_TRUE(budget.ChargeBytes(10).ok());
+  auto status = budget.ChargeBytes(1);
+  EXPECT_TRUE(absl::IsResourceExhausted(status));
+  // Even a charge that fits fails now.
+  EXPECT_EQ(budget.ChargeValue(0), status);
+  EXPECT_EQ(budget.status(), status);
+}
+
+TEST(ParseBudgetTracker, ChargeArgs) {
+  const char* argv[] = {"prog", "--flag", "value"};
+  ParseBudget limits;
+  limits.max_tokens = 3;
+  ParseBudgetTracker budget(limits);
+  EXPECT_TRUE(budget.ChargeArgs(ArgArray(3, argv)).ok());
+  EXPECT_EQ(budget.GetTokensUsed(), 3);
+  // Including the NULs.
+  EXPECT_EQ(budget.GetBytesUsed(), 5 + 7 + 6);
+
+  limits.max_tokens = 2;
+  ParseBudgetTracker small(limits);
+  EXPECT_TRUE(absl::IsResourceExhausted(small.ChargeArgs(ArgArray(3, argv))));
+}
+
+std::unique_ptr<Argument> MakeAppendArgument(std::vector<int>* dest) {
+  ArgumentBuilder builder;
+  builder.SetSingleName("--num");
+  builder.SetDest(DestInfo::CreateFromPtr(dest));
+  builder.SetActionString("append");
+  return builder.Build();
+}
+
+TEST(ParseBudget, AppendStopsAtValueLimit) {
+  std::vector<int> dest;
+  auto arg = MakeAppendArgument(&dest);
+  ParseBudget limits;
+  limits.max_values = 2;
+  ParseBudgetTracker budget(limits);
+
+  EXPECT_TRUE(arg->Run(absl::string_view("1"), &budget).ok());
+  EXPECT_TRUE(arg->Run(absl::string_view("2"), &budget).ok());
+  EXPECT_TRUE(absl::IsResourceExhausted(
+      arg->Run(absl::string_view("3"), &budget)));
+  // The dest didn't grow beyond the limit.
+  EXPECT_EQ(dest, (std::vector<int>{1, 2}));
+}
+
+TEST(ParseBudget, AppendedBytesAreCharged) {
+  std::vector<int> dest;
+  auto arg = MakeAppendArgument(&dest);
+  ParseBudget limits;
+  limits.max_bytes = 3 * (sizeof(int) + 2);
+  ParseBudgetTracker budget(limits);
+
+  for (int i = 10; i < 13; ++i)
+    EXPECT_TRUE(arg->Run(absl::string_view(std::to_string(i)), &budget).ok());
+  EXPECT_FALSE(arg->Run(absl::string_view("13"), &budget).ok());
+  EXPECT_EQ(dest.size(), 3);
+}
+
+TEST(ParseBudget, InvalidValueIsTruncatedInError) {
+  std::vector<int> dest;
+  auto arg = MakeAppendArgument(&dest);
+  ParseBudgetTracker budget{ParseBudget()};
+  std::string hostile(1 << 20, 'x');
+  auto status = arg->Run(absl::string_view(hostile), &budget);
+  EXPECT_TRUE(absl::IsInvalidArgument(status));
+  EXPECT_LT(status.message().size(), 200);
+  EXPECT_TRUE(dest.empty());
+}
+
+TEST(ParseBudget, OversizedArgvIsRefused) {
+  int dest = 0;
+  argparse::ArgumentParser parser;
+  ParseBudget limits;
+  limits.max_tokens = 4;
+  parser.Budget(limits).AddArgument(argparse::Argument("--num", &dest));
+
+  std::vector<const char*> argv(100, "--num=1");
+  argv[0] = "prog";
+  std::vector<std::string> rest;
+  auto status = parser.TryParseKnownArgs(argv.size(), argv.data(), &rest);
+  EXPECT_TRUE(absl::IsResourceExhausted(status));
+  EXPECT_EQ(dest, 0);
+}
+
+}  // namespace testing_internal
+}  // namespace internal
+}  // namespace argparse
@@ -0,0 +1,119 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "argparse/internal/argparse-parse-float.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <system_error>
+
+#if defined(__GLIBC__) || defined(__APPLE__) || defined(__FreeBSD__)
+#include <locale.h>
+#if defined(__APPLE__) || defined(__FreeBSD__)
+#include <xlocale.h>
+#endif
+#define ARGPARSE_HAVE_STRTOLD_L 1
+#endif
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/charconv.h"
+
+namespace argparse {
+namespace internal {
+namespace {
+
+// Remove the whitespace and a leading `+`, which from_chars() doesn't take.
+// Refuse what std::from_chars() doesn't take, but absl::from_chars() or
+// strtold() do: hex numbers, and space or another sign after the sign.
+bool Prepare(absl::string_view* str) {
+  *str = absl::StripAsciiWhitespace(*str);
+  bool plus = !str->empty() && str->front() == '+';
+  if (plus) str->remove_prefix(1);
+  bool minus = !plus && !str->empty() && str->front() == '-';
+  auto digits = minus ? str->substr(1) : *str;
+  if (digits.empty() || digits.front() == '-' || digits.front() == '+' ||
+      absl::ascii_isspace(digits.front()))
+    return false;
+  return !(digits.size() >= 2 && digits[0] == '0' &&
+           absl::ascii_tolower(digits[1]) == 'x');
+}
+
+template <typename T>
+bool FromChars(absl::string_view str, T* out) {
+  if (!Prepare(&str)) return false;
+  T value;
+  auto result = absl::from_chars(str.data(), str.data() + str.size(), value);
+  if (result.ec != std::errc() || result.ptr != str.data() + str.size())
+    return false;
+  *out = value;
+  return true;
+}
+
+#ifdef ARGPARSE_HAVE_STRTOLD_L
+// Created once, it is never changed.
+locale_t GetCLocale() {
+  static const locale_t kLocale = newlocale(LC_ALL_MASK, "C", locale_t());
+  return kLocale;
+}
+#endif
+
+// strtold() wants a NUL, so the input is copied to the stack. Any longer
+// number has a lot of redundant digits and goes to the heap.
+constexpr std::size_t kMaxLongDoubleOnStack = 128;
+
+bool StrToLongDouble(absl::string_view str, long double* out) {
+  if (!Prepare(&str)) return false;
+
+  char stack[kMaxLongDoubleOnStack];
+  std::string heap;
+  const char* buffer = stack;
+  if (str.size() < sizeof(stack)) {
+    str.copy(stack, str.size());
+    stack[str.size()] = '\0';
+  } else {
+    heap.assign(str.data(), str.size());
+    buffer = heap.c_str();
+  }
+
+  char* end = nullptr;
+  errno = 0;
+#ifdef ARGPARSE_HAVE_STRTOLD_L
+  long double value = strtold_l(buffer, &end, GetCLocale());
+#else
+  long double value = std::strtold(buffer, &end);
+#endif
+  if (errno == ERANGE || end != buffer + str.size()) return false;
+  *out = value;
+  return true;
+}
+
+}  // namespace
+
+bool ParseFloat(absl::string_view str, float* out) {
+  return FromChars(str, out);
+}
+
+bool ParseFloat(absl::string_view str, double* out) {
+  return FromChars(str, out);
+}
+
+bool ParseFloat(absl::string_view str, long double* out) {
+  // Where it is just a double (e.g., MSVC), from_chars() does it.
+  if (std::numeric_limits<long double>::digits ==
+          std::numeric_limits<double>::digits &&
+      std::numeric_limits<long double>::max_exponent ==
+          std::numeric_limits<double>::max_exponent) {
+    double value;
+    if (!FromChars(str, &value)) return false;
+    *out = value;
+    return true;
+  }
+  return StrToLongDouble(str, out);
+}
+
+}  // namespace internal
+}  // namespace argparse
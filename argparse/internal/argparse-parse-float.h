@@ -0,0 +1,25 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "absl/strings/string_view.h"
+
+namespace argparse {
+namespace internal {
+
+// Parse a floating-point number with the semantics of std::from_chars(): a
+// decimal number with an optional exponent, or inf/nan. Also accepted are a
+// leading `+` and ASCII whitespace around the number, like absl::SimpleAtod().
+// The whole input must be taken, and it fails on a value out of range of the
+// type. It neither throws nor depends on the locale, and only a long double
+// of 128 chars or more is copied to the heap, so a malformed input costs no
+// more than a good one. On failure, `*out` is untouched.
+bool ParseFloat(absl::string_view str, float* out);
+bool ParseFloat(absl::string_view str, double* out);
+bool ParseFloat(absl::string_view str, long double* out);
+
+}  // namespace internal
+}  // namespace argparse
@@ -0,0 +1,80 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "argparse/internal/argparse-parse-float.h"
+
+#include <clocale>
+#include <cmath>
+#include <limits>
+
+#include "argparse/internal/argparse-parse-traits.h"
+#include "gtest/gtest.h"
+
+namespace argparse {
+namespace internal {
+namespace testing_internal {
+
+template <typename T>
+class ParseFloatTest : public ::testing::Test {};
+
+using FloatTypes = ::testing::Types<float, double, long double>;
+
+TYPED_TEST_SUITE(ParseFloatTest, FloatTypes);
+
+TYPED_TEST(ParseFloatTest, TakesFromCharsSyntax) {
+  TypeParam value;
+  EXPECT_TRUE(Parse("1.5", &value));
+  EXPECT_EQ(value, TypeParam(1.5));
+  EXPECT_TRUE(Parse(" +2.5e3 ", &value));
+  EXPECT_EQ(value, TypeParam(2500));
+  EXPECT_TRUE(Parse("-.25", &value));
+  EXPECT_EQ(value, TypeParam(-0.25));
+  EXPECT_TRUE(Parse("-inf", &value));
+  EXPECT_TRUE(std::isinf(value));
+  EXPECT_TRUE(Parse("nan", &value));
+  EXPECT_TRUE(std::isnan(value));
+}
+
+TYPED_TEST(ParseFloatTest, RejectsPartialAndMalformedInput) {
+  TypeParam value = 7;
+  for (const char* input :
+       {"", " ", "+", "+-1", "1.5x", "1e", "1,5", "0x1p3", "--1", "1 2"}) {
+    EXPECT_FALSE(Parse(input, &value)) << input;
+  }
+  EXPECT_EQ(value, 7);
+}
+
+TYPED_TEST(ParseFloatTest, RejectsOutOfRange) {
+  TypeParam value;
+  EXPECT_FALSE(Parse("1e100000", &value));
+  EXPECT_TRUE(Parse(std::to_string(std::numeric_limits<float>::max()), &value));
+}
+
+TEST(ParseFloat, LongDoubleKeepsItsPrecision) {
+  long double value;
+  // Not representable as a double.
+  EXPECT_TRUE(ParseFloat("1.00000000000000000001", &value));
+  if (std::numeric_limits<long double>::digits > 64) {
+    EXPECT_GT(value, 1.0L);
+  }
+  // Longer than the stack buffer.
+  std::string long_input = "1." + std::string(300, '0') + "1";
+  EXPECT_TRUE(ParseFloat(long_input, &value));
+}
+
+TEST(ParseFloat, IgnoresTheLocale) {
+  // A locale with a decimal comma, if it is installed.
+  const char* old = std::setlocale(LC_NUMERIC, nullptr);
+  std::string saved = old ? old : "C";
+  if (!std::setlocale(LC_NUMERIC, "de_DE.UTF-8")) GTEST_SKIP();
+  long double value;
+  EXPECT_TRUE(ParseFloat("1.5", &value));
+  EXPECT_EQ(value, 1.5L);
+  std::setlocale(LC_NUMERIC, saved.c_str());
+}
+
+}  // namespace testing_internal
+}  // namespace internal
+}  // namespace argparse
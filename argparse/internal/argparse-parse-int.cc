@@ -0,0 +1,169 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "argparse/internal/argparse-parse-int.h"
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/strip.h"
+
+namespace argparse {
+namespace internal {
+namespace parse_int_internal {
+namespace {
+
+constexpr std::uint64_t kMax = std::numeric_limits<std::uint64_t>::max();
+
+// Compilers turn this into a single load on little-endian machines.
+std::uint64_t LoadLittleEndian64(const char* p) {
+  std::uint64_t value = 0;
+  for (int i = 7; i >= 0; --i)
+    value = (value << 8) | static_cast<unsigned char>(p[i]);
+  return value;
+}
+
+// Whether each byte of `chunk` is in '0'..'9'. Adding 6 carries a byte above
+// '9' into the high nibble.
+bool IsEightDigits(std::uint64_t chunk) {
+  constexpr std::uint64_t kHigh = 0xF0F0F0F0F0F0F0F0;
+  return ((chunk & kHigh) |
+          (((chunk + 0x0606060606060606) & kHigh) >> 4)) ==
+         0x3333333333333333;
+}
+
+// The value of 8 decimal digits, the first one in the lowest byte. Each step
+// combines adjacent lanes, so it takes 3 multiplies instead of 8.
+std::uint32_t ParseEightDigits(std::uint64_t chunk) {
+  constexpr std::uint64_t kMask = 0x000000FF000000FF;
+  constexpr std::uint64_t kMul1 = 100 + (1000000ULL << 32);
+  constexpr std::uint64_t kMul2 = 1 + (10000ULL << 32);
+  chunk -= 0x3030303030303030;
+  // Pairs of digits.
+  chunk = (chunk * 10) + (chunk >> 8);
+  // Then groups of 4 and 8.
+  chunk = ((chunk & kMask) * kMul1 + ((chunk >> 16) & kMask) * kMul2) >> 32;
+  return static_cast<std::uint32_t>(chunk);
+}
+
+int DigitValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+// Parse `digits` in `base` (2, 8, 10 or 16), with single `_` between digits.
+bool ParseDigits(absl::string_view digits, int base, std::uint64_t* out) {
+  // log2 of base, for the power-of-2 bases.
+  const int shift = base == 16 ? 4 : base == 8 ? 3 : base == 2 ? 1 : 0;
+  const char* p = digits.data();
+  const std::size_t size = digits.size();
+  std::uint64_t value = 0;
+  bool after_digit = false;
+  std::size_t i = 0;
+  while (i < size) {
+    if (base == 10 && size - i >= 8) {
+      auto chunk = LoadLittleEndian64(p + i);
+      if (IsEightDigits(chunk)) {
+        constexpr std::uint64_t kScale = 100000000;
+        auto eight = ParseEightDigits(chunk);
+        if (value > (kMax - eight) / kScale) return false;
+        value = value * kScale + eight;
+        after_digit = true;
+        i += 8;
+        continue;
+      }
+    }
+    char c = p[i++];
+    if (base == 10 && static_cast<unsigned char>(c - '0') <= 9) {
+      auto d = static_cast<std::uint64_t>(c - '0');
+      if (value > kMax / 10 || (value == kMax / 10 && d > kMax % 10))
+        return false;
+      value = value * 10 + d;
+      after_digit = true;
+      continue;
+    }
+    if (c == '_') {
+      // Not leading, not doubled.
+      if (!after_digit) return false;
+      after_digit = false;
+      continue;
+    }
+    // Decimal digits are taken above.
+    int digit = DigitValue(c);
+    if (!shift || digit < 0 || digit >= base) return false;
+    if (value >> (64 - shift)) return false;
+    value = (value << shift) | static_cast<std::uint64_t>(digit);
+    after_digit = true;
+  }
+  // Not empty, and no trailing `_`.
+  if (!after_digit) return false;
+  *out = value;
+  return true;
+}
+
+// The size suffixes and their factors.
+struct Suffix {
+  absl::string_view name;
+  std::uint64_t factor;
+};
+constexpr Suffix kSuffixes[] = {
+    {"k", 1000},        {"M", 1000000},     {"G", 1000000000},
+    {"Ki", 1ULL << 10}, {"Mi", 1ULL << 20}, {"Gi", 1ULL << 30},
+};
+
+// Remove a size suffix from `str` and return its factor, or 1 if there is
+// none.
+std::uint64_t ConsumeSuffix(absl::string_view* str) {
+  // The common case.
+  if (str->empty() || absl::ascii_isdigit(str->back())) return 1;
+  for (const auto& suffix : kSuffixes) {
+    if (absl::ConsumeSuffix(str, suffix.name)) return suffix.factor;
+  }
+  return 1;
+}
+
+}  // namespace
+
+bool ParseIntegerMagnitude(absl::string_view str, bool* negative,
+                           std::uint64_t* magnitude) {
+  str = absl::StripAsciiWhitespace(str);
+  *negative = false;
+  if (!str.empty() && (str.front() == '+' || str.front() == '-')) {
+    *negative = str.front() == '-';
+    str.remove_prefix(1);
+  }
+
+  int base = 10;
+  if (str.size() >= 2 && str[0] == '0') {
+    switch (str[1]) {
+      case 'x':
+      case 'X':
+        base = 16;
+        break;
+      case 'o':
+      case 'O':
+        base = 8;
+        break;
+      case 'b':
+      case 'B':
+        base = 2;
+        break;
+      default:
+        break;
+    }
+    if (base != 10) str.remove_prefix(2);
+  }
+
+  auto factor = ConsumeSuffix(&str);
+  std::uint64_t value;
+  if (!ParseDigits(str, base, &value)) return false;
+  if (value > kMax / factor) return false;
+  *magnitude = value * factor;
+  return true;
+}
+
+}  // namespace parse_int_internal
+}  // namespace internal
+}  // namespace argparse
@@ -0,0 +1,72 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "absl/strings/string_view.h"
+
+namespace argparse {
+namespace internal {
+namespace parse_int_internal {
+
+// Parse the sign and the magnitude of an integer of the form:
+//   [+-] [0x | 0o | 0b] digits [k | M | G | Ki | Mi | Gi]
+// - The prefix selects base 16, 8 or 2, the default is 10. A leading 0 alone
+//   doesn't mean octal.
+// - A single `_` may separate two digits, e.g., 1_000_000.
+// - The suffix multiplies by 10^3, 10^6, 10^9 or 2^10, 2^20, 2^30.
+// - ASCII whitespace around the number is ignored.
+// Return false on a syntax error, or if the magnitude doesn't fit uint64_t.
+bool ParseIntegerMagnitude(absl::string_view str, bool* negative,
+                           std::uint64_t* magnitude);
+
+// Integer types that are parsed as numbers (not bool or the character types).
+template <typename T>
+struct IsParsedAsInteger
+    : std::integral_constant<
+          bool, std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+                    !std::is_same<T, char>::value &&
+                    !std::is_same<T, wchar_t>::value &&
+                    !std::is_same<T, char16_t>::value &&
+                    !std::is_same<T, char32_t>::value> {};
+
+// Parse an integer of any width, see ParseIntegerMagnitude() for the syntax.
+// Fail if the value is out of range of T, in which case `*out` is untouched.
+template <typename T>
+bool ParseInteger(absl::string_view str, T* out) {
+  static_assert(IsParsedAsInteger<T>::value, "T must be an integer type");
+  bool negative;
+  std::uint64_t magnitude;
+  if (!ParseIntegerMagnitude(str, &negative, &magnitude)) return false;
+  constexpr auto kMax =
+      static_cast<std::uint64_t>(std::numeric_limits<T>::max());
+  if (!negative) {
+    if (magnitude > kMax) return false;
+    *out = static_cast<T>(magnitude);
+    return true;
+  }
+  // -0 is fine for unsigned types.
+  if (magnitude == 0) {
+    *out = 0;
+    return true;
+  }
+  // The magnitude of min() is max() + 1.
+  if (!std::is_signed<T>::value || magnitude - 1 > kMax) return false;
+  // Negate in T so that min() doesn't overflow.
+  *out = static_cast<T>(-static_cast<T>(magnitude - 1) - 1);
+  return true;
+}
+
+}  // namespace parse_int_internal
+
+using parse_int_internal::IsParsedAsInteger;
+using parse_int_internal::ParseInteger;
+
+}  // namespace internal
+}  // namespace argparse
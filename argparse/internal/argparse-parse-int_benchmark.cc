@@ -0,0 +1,70 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "absl/strings/numbers.h"
+#include "argparse/internal/argparse-parse-int.h"
+#include "argparse/internal/argparse-std-parse.h"
+#include "benchmark/benchmark.h"
+
+// ParseInteger() against the paths it replaced: absl::SimpleAtoi() and
+// std::stoll() through StdParse().
+namespace argparse {
+namespace internal {
+namespace {
+
+// Decimal numbers of about `digits` digits.
+std::vector<std::string> MakeInputs(int digits) {
+  std::mt19937_64 rng(42);
+  std::uint64_t limit = 1;
+  for (int i = 1; i < digits; ++i) limit *= 10;
+  std::vector<std::string> inputs;
+  for (int i = 0; i < 1024; ++i)
+    inputs.push_back(std::to_string(limit + rng() % (9 * limit)));
+  return inputs;
+}
+
+template <typename ParseFunc>
+void RunParse(benchmark::State& state, ParseFunc parse) {
+  const auto inputs = MakeInputs(static_cast<int>(state.range(0)));
+  std::size_t i = 0;
+  for (auto _ : state) {
+    long long value;
+    benchmark::DoNotOptimize(parse(inputs[i++ % inputs.size()], &value));
+    benchmark::DoNotOptimize(value);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_ParseInteger(benchmark::State& state) {
+  RunParse(state, [](absl::string_view in, long long* out) {
+    return ParseInteger(in, out);
+  });
+}
+BENCHMARK(BM_ParseInteger)->Arg(2)->Arg(8)->Arg(18);
+
+void BM_SimpleAtoi(benchmark::State& state) {
+  RunParse(state, [](absl::string_view in, long long* out) {
+    return absl::SimpleAtoi(in, out);
+  });
+}
+BENCHMARK(BM_SimpleAtoi)->Arg(2)->Arg(8)->Arg(18);
+
+void BM_StdParse(benchmark::State& state) {
+  RunParse(state, [](absl::string_view in, long long* out) {
+    return StdParse(in, out);
+  });
+}
+BENCHMARK(BM_StdParse)->Arg(2)->Arg(8)->Arg(18);
+
+}  // namespace
+}  // namespace internal
+}  // namespace argparse
+
+BENCHMARK_MAIN();
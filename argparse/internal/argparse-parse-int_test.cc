@@ -0,0 +1,120 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "argparse/internal/argparse-parse-int.h"
+
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include "argparse/internal/argparse-parse-traits.h"
+#include "gtest/gtest.h"
+
+namespace argparse {
+namespace internal {
+namespace testing_internal {
+
+template <typename T>
+class ParseIntegerTest : public ::testing::Test {};
+
+using IntegerTypes =
+    ::testing::Types<signed char, unsigned char, short, unsigned short, int,
+                     unsigned, long, unsigned long, long long,
+                     unsigned long long>;
+
+TYPED_TEST_SUITE(ParseIntegerTest, IntegerTypes);
+
+TYPED_TEST(ParseIntegerTest, ExactRange) {
+  using Limits = std::numeric_limits<TypeParam>;
+  TypeParam value;
+  EXPECT_TRUE(Parse(std::to_string(Limits::max()), &value));
+  EXPECT_EQ(value, Limits::max());
+  EXPECT_TRUE(Parse(std::to_string(Limits::min()), &value));
+  EXPECT_EQ(value, Limits::min());
+
+  // One beyond each end.
+  auto max = static_cast<unsigned long long>(Limits::max());
+  if (max < std::numeric_limits<unsigned long long>::max()) {
+    EXPECT_FALSE(Parse(std::to_string(max + 1), &value));
+  }
+  auto min_magnitude = Limits::is_signed ? max + 1 : 0;
+  EXPECT_FALSE(Parse("-" + std::to_string(min_magnitude + 1), &value));
+}
+
+TEST(ParseInteger, Prefixes) {
+  int value;
+  EXPECT_TRUE(ParseInteger("0x1F", &value));
+  EXPECT_EQ(value, 31);
+  EXPECT_TRUE(ParseInteger("-0o17", &value));
+  EXPECT_EQ(value, -15);
+  EXPECT_TRUE(ParseInteger("0b101", &value));
+  EXPECT_EQ(value, 5);
+  // Not octal.
+  EXPECT_TRUE(ParseInteger("010", &value));
+  EXPECT_EQ(value, 10);
+  EXPECT_FALSE(ParseInteger("0x", &value));
+  EXPECT_FALSE(ParseInteger("0b2", &value));
+  EXPECT_FALSE(ParseInteger("0o8", &value));
+}
+
+TEST(ParseInteger, Separators) {
+  std::uint64_t value;
+  EXPECT_TRUE(ParseInteger("1_000_000_000_000", &value));
+  EXPECT_EQ(value, 1000000000000);
+  EXPECT_TRUE(ParseInteger("0xdead_beef", &value));
+  EXPECT_EQ(value, 0xdeadbeef);
+  EXPECT_FALSE(ParseInteger("_1", &value));
+  EXPECT_FALSE(ParseInteger("1_", &value));
+  EXPECT_FALSE(ParseInteger("1__0", &value));
+  EXPECT_FALSE(ParseInteger("0x_1", &value));
+}
+
+TEST(ParseInteger, Suffixes) {
+  std::uint64_t value;
+  EXPECT_TRUE(ParseInteger("4k", &value));
+  EXPECT_EQ(value, 4000);
+  EXPECT_TRUE(ParseInteger("4Ki", &value));
+  EXPECT_EQ(value, 4096);
+  EXPECT_TRUE(ParseInteger("3Mi", &value));
+  EXPECT_EQ(value, 3 << 20);
+  EXPECT_TRUE(ParseInteger("2G", &value));
+  EXPECT_EQ(value, 2000000000);
+  EXPECT_FALSE(ParseInteger("4K", &value));
+  EXPECT_FALSE(ParseInteger("k", &value));
+
+  int small;
+  EXPECT_TRUE(ParseInteger("1Gi", &small));
+  EXPECT_FALSE(ParseInteger("2Gi", &small));
+  EXPECT_TRUE(ParseInteger("-2Gi", &small));
+  EXPECT_EQ(small, std::numeric_limits<int>::min());
+  // The product overflows 64 bits.
+  EXPECT_FALSE(ParseInteger("20000000000G", &value));
+}
+
+TEST(ParseInteger, LongDecimalsUseEveryChunk) {
+  std::uint64_t value;
+  EXPECT_TRUE(ParseInteger("18446744073709551615", &value));
+  EXPECT_EQ(value, std::numeric_limits<std::uint64_t>::max());
+  EXPECT_FALSE(ParseInteger("18446744073709551616", &value));
+  EXPECT_FALSE(ParseInteger("99999999999999999999", &value));
+  EXPECT_TRUE(ParseInteger("00000000000000000000001", &value));
+  EXPECT_EQ(value, 1);
+  EXPECT_FALSE(ParseInteger("1234567a", &value));
+  EXPECT_FALSE(ParseInteger("12345678:", &value));
+}
+
+TEST(ParseInteger, FailureLeavesOutputAlone) {
+  short value = 7;
+  EXPECT_FALSE(ParseInteger("", &value));
+  EXPECT_FALSE(ParseInteger("-", &value));
+  EXPECT_FALSE(ParseInteger("40000", &value));
+  EXPECT_EQ(value, 7);
+  EXPECT_TRUE(ParseInteger(" 12 ", &value));
+  EXPECT_EQ(value, 12);
+}
+
+}  // namespace testing_internal
+}  // namespace internal
+}  // namespace argparse
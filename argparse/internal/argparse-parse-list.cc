@@ -0,0 +1,84 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "argparse/internal/argparse-parse-list.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "absl/base/config.h"
+
+namespace argparse {
+namespace internal {
+namespace parse_list_internal {
+
+std::size_t CountChar(absl::string_view str, char c) {
+  constexpr std::uint64_t kOnes = 0x0101010101010101;
+  constexpr std::uint64_t kLow7 = 0x7F7F7F7F7F7F7F7F;
+  const std::uint64_t pattern = kOnes * static_cast<unsigned char>(c);
+  const char* p = str.data();
+  const char* end = p + str.size();
+  std::size_t count = 0;
+  for (; end - p >= 8; p += 8) {
+    std::uint64_t chunk;
+    std::memcpy(&chunk, p, sizeof(chunk));
+    // A byte of `x` is 0 where it matches. Its high bit in `nonzero` is set
+    // unless the byte is 0, without carries between the bytes.
+    std::uint64_t x = chunk ^ pattern;
+    std::uint64_t nonzero = ((x & kLow7) + kLow7) | x;
+    std::uint64_t matches = (~nonzero >> 7) & kOnes;
+    // Sum the bytes into the top one.
+    count += static_cast<std::size_t>((matches * kOnes) >> 56);
+  }
+  for (; p != end; ++p) count += *p == c;
+  return count;
+}
+
+std::size_t ParallelFindFirst(
+    std::size_t n, absl::FunctionRef<std::size_t(std::size_t, std::size_t)> fn,
+    std::size_t max_threads) {
+  // hardware_concurrency() may be 0 if it is not known.
+  if (!max_threads) max_threads = std::thread::hardware_concurrency();
+  auto threads = std::min(max_threads, n / kMinValuesPerThread);
+  if (threads <= 1) return fn(0, n);
+
+  const std::size_t slice = (n + threads - 1) / threads;
+  std::vector<std::size_t> results(threads);
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  // The slices from `started` on are done on this thread.
+  std::size_t started = 1;
+#ifdef ABSL_HAVE_EXCEPTIONS
+  try {
+#endif
+    for (; started < threads; ++started) {
+      auto t = started;
+      workers.emplace_back([&results, fn, slice, n, t] {
+        results[t] = fn(t * slice, std::min(n, (t + 1) * slice));
+      });
+    }
+#ifdef ABSL_HAVE_EXCEPTIONS
+  } catch (const std::system_error&) {
+    // Out of threads. This may run inside a C callback, so don't throw.
+  }
+#endif
+  results[0] = fn(0, std::min(n, slice));
+  for (auto t = started; t < threads; ++t)
+    results[t] = fn(t * slice, std::min(n, (t + 1) * slice));
+  for (auto& worker : workers) worker.join();
+
+  // The slices are in order, so the first bad one has the first bad index.
+  for (std::size_t t = 0; t < threads; ++t) {
+    if (results[t] != std::min(n, (t + 1) * slice)) return results[t];
+  }
+  return n;
+}
+
+}  // namespace parse_list_internal
+}  // namespace internal
+}  // namespace argparse
@@ -0,0 +1,127 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "absl/functional/function_ref.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "argparse/internal/argparse-parse-float.h"
+#include "argparse/internal/argparse-parse-int.h"
+
+// Bulk parsing of a list of numbers in one token, like "0.5,1e-3,2".
+namespace argparse {
+namespace internal {
+namespace parse_list_internal {
+
+// The number of `c` in `str`. The bytes are compared 8 at a time.
+std::size_t CountChar(absl::string_view str, char c);
+
+// Below this many values, ParallelFindFirst() stays on the calling thread.
+constexpr std::size_t kMinValuesPerThread = 1 << 14;
+
+// Split [0, n) into slices and run `fn(begin, end)` on each, on up to
+// `max_threads` threads (0 for hardware_concurrency()) when n is large. `fn`
+// returns the first bad index in its slice, or `end`. Return the first bad
+// index overall, or n. If a thread can't be started, its slices are run on
+// the calling thread.
+std::size_t ParallelFindFirst(
+    std::size_t n, absl::FunctionRef<std::size_t(std::size_t, std::size_t)> fn,
+    std::size_t max_threads = 0);
+
+// Element types of a list that are parsed in bulk.
+template <typename T>
+struct IsListNumber
+    : std::integral_constant<bool, IsParsedAsInteger<T>::value ||
+                                       std::is_floating_point<T>::value> {};
+
+template <typename T>
+struct IsNumberList : std::false_type {};
+template <typename T, typename Alloc>
+struct IsNumberList<std::vector<T, Alloc>> : IsListNumber<T> {};
+
+template <typename T>
+bool ParseListNumber(std::true_type, absl::string_view str, T* out) {
+  return ParseInteger(str, out);
+}
+template <typename T>
+bool ParseListNumber(std::false_type, absl::string_view str, T* out) {
+  return ParseFloat(str, out);
+}
+
+// Parse `in`, numbers separated by `delimiter`, and append them to `out`.
+// The vector grows once for all of them, and each is converted right into
+// its place. Each number takes the syntax of ParseInteger() or ParseFloat().
+// On failure, `*bad_index` is the index of the first bad number in `in`, and
+// the ones before it are kept.
+template <typename T, typename Alloc>
+bool AppendNumberList(absl::string_view in, char delimiter,
+                      std::vector<T, Alloc>* out, std::size_t* bad_index) {
+  static_assert(IsListNumber<T>::value, "T must be a number type");
+  const std::size_t old_size = out->size();
+  const std::size_t count = CountChar(in, delimiter) + 1;
+  out->resize(old_size + count);
+  T* values = out->data() + old_size;
+  const char* begin = in.data();
+  const char* end = begin + in.size();
+  for (std::size_t i = 0; i < count; ++i) {
+    // memchr() is vectorized by the libc. The last piece runs to the end.
+    auto* stop = static_cast<const char*>(
+        std::memchr(begin, delimiter, static_cast<std::size_t>(end - begin)));
+    if (!stop) stop = end;
+    if (!ParseListNumber(IsParsedAsInteger<T>{},
+                         absl::string_view(begin, stop - begin), values + i)) {
+      out->resize(old_size + i);
+      *bad_index = i;
+      return false;
+    }
+    begin = stop + 1;
+  }
+  return true;
+}
+
+// Parse each of `values` as a number and append them to `out`, with the same
+// syntax and failure contract as AppendNumberList(). The vector grows once.
+// A large batch is converted on up to `max_threads` threads, see
+// ParallelFindFirst(). Threads are only started if asked for.
+template <typename T, typename Alloc>
+bool AppendNumbers(absl::Span<const absl::string_view> values,
+                   std::vector<T, Alloc>* out, std::size_t* bad_index,
+                   std::size_t max_threads = 1) {
+  static_assert(IsListNumber<T>::value, "T must be a number type");
+  const std::size_t old_size = out->size();
+  out->resize(old_size + values.size());
+  T* numbers = out->data() + old_size;
+  auto bad = ParallelFindFirst(
+      values.size(), [values, numbers](std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; ++i) {
+          if (!ParseListNumber(IsParsedAsInteger<T>{}, values[i],
+                               numbers + i))
+            return i;
+        }
+        return end;
+      },
+      max_threads);
+  if (bad == values.size()) return true;
+  out->resize(old_size + bad);
+  *bad_index = bad;
+  return false;
+}
+
+}  // namespace parse_list_internal
+
+using parse_list_internal::AppendNumberList;
+using parse_list_internal::AppendNumbers;
+using parse_list_internal::CountChar;
+using parse_list_internal::kMinValuesPerThread;
+using parse_list_internal::ParallelFindFirst;
+using parse_list_internal::IsNumberList;
+
+}  // namespace internal
+}  // namespace argparse
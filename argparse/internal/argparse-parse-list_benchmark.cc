@@ -0,0 +1,65 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_split.h"
+#include "argparse/internal/argparse-parse-list.h"
+#include "benchmark/benchmark.h"
+
+// AppendNumberList() against splitting into strings first and converting
+// each of them.
+namespace argparse {
+namespace internal {
+namespace {
+
+// `count` comma-separated floats.
+std::string MakeInput(int count) {
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> dist(-1, 1);
+  std::string in;
+  for (int i = 0; i < count; ++i) {
+    if (i) in.push_back(',');
+    in += std::to_string(dist(rng));
+  }
+  return in;
+}
+
+void BM_AppendNumberList(benchmark::State& state) {
+  const auto in = MakeInput(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    std::vector<double> values;
+    std::size_t bad_index;
+    benchmark::DoNotOptimize(AppendNumberList(in, ',', &values, &bad_index));
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetBytesProcessed(state.iterations() * in.size());
+}
+BENCHMARK(BM_AppendNumberList)->Arg(1000)->Arg(200000);
+
+void BM_SplitThenSimpleAtod(benchmark::State& state) {
+  const auto in = MakeInput(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    std::vector<std::string> pieces = absl::StrSplit(in, ',');
+    std::vector<double> values;
+    for (const auto& piece : pieces) {
+      double value;
+      if (!absl::SimpleAtod(piece, &value)) break;
+      values.push_back(value);
+    }
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetBytesProcessed(state.iterations() * in.size());
+}
+BENCHMARK(BM_SplitThenSimpleAtod)->Arg(1000)->Arg(200000);
+
+}  // namespace
+}  // namespace internal
+}  // namespace argparse
+
+BENCHMARK_MAIN();
@@ -0,0 +1,129 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "argparse/internal/argparse-parse-list.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace argparse {
+namespace internal {
+namespace testing_internal {
+
+TEST(CountChar, MatchesStdCount) {
+  // Every length around the 8-byte chunks, with bytes that have the high bit
+  // set next to the ones that match.
+  std::string str;
+  for (int i = 0; i < 40; ++i) {
+    EXPECT_EQ(CountChar(str, ','), std::count(str.begin(), str.end(), ','));
+    EXPECT_EQ(CountChar(str, '\xAC'),
+              std::count(str.begin(), str.end(), '\xAC'));
+    str.push_back(i % 3 == 0 ? ',' : i % 3 == 1 ? '\xAC' : '\x80');
+  }
+  EXPECT_EQ(CountChar("", ','), 0);
+  EXPECT_EQ(CountChar(std::string(1000, ','), ','), 1000);
+}
+
+TEST(AppendNumberList, Integers) {
+  std::vector<int> values{7};
+  std::size_t bad_index;
+  EXPECT_TRUE(AppendNumberList("1, 2,0x10,1k,-5", ',', &values, &bad_index));
+  EXPECT_EQ(values, (std::vector<int>{7, 1, 2, 16, 1000, -5}));
+}
+
+TEST(AppendNumberList, Floats) {
+  std::vector<double> values;
+  std::size_t bad_index;
+  EXPECT_TRUE(AppendNumberList("0.5:1e-3:-2", ':', &values, &bad_index));
+  EXPECT_EQ(values, (std::vector<double>{0.5, 1e-3, -2}));
+}
+
+TEST(AppendNumberList, LongList) {
+  std::string in;
+  std::vector<std::int64_t> expected;
+  for (int i = 0; i < 10000; ++i) {
+    if (i) in.push_back(',');
+    in += std::to_string(i * 7919LL);
+    expected.push_back(i * 7919LL);
+  }
+  std::vector<std::int64_t> values;
+  std::size_t bad_index;
+  EXPECT_TRUE(AppendNumberList(in, ',', &values, &bad_index));
+  EXPECT_EQ(values, expected);
+}
+
+TEST(AppendNumberList, KeepsValuesBeforeBadOne) {
+  std::vector<unsigned> values{7};
+  std::size_t bad_index;
+  EXPECT_FALSE(AppendNumberList("1,2,-3,4", ',', &values, &bad_index));
+  EXPECT_EQ(bad_index, 2);
+  EXPECT_EQ(values, (std::vector<unsigned>{7, 1, 2}));
+
+  // Empty pieces are not numbers.
+  values.clear();
+  EXPECT_FALSE(AppendNumberList("1,,2", ',', &values, &bad_index));
+  EXPECT_EQ(bad_index, 1);
+  EXPECT_FALSE(AppendNumberList("", ',', &values, &bad_index));
+  EXPECT_EQ(bad_index, 0);
+}
+
+TEST(AppendNumbers, ReportsFirstBadValue) {
+  // Enough values for several threads.
+  constexpr std::size_t kCount = 8 * kMinValuesPerThread;
+  std::vector<std::string> storage;
+  for (std::size_t i = 0; i < kCount; ++i)
+    storage.push_back(std::to_string(i));
+  std::vector<absl::string_view> values(storage.begin(), storage.end());
+
+  std::vector<std::uint32_t> numbers{7};
+  std::size_t bad_index;
+  EXPECT_TRUE(AppendNumbers(values, &numbers, &bad_index, 4));
+  ASSERT_EQ(numbers.size(), kCount + 1);
+  for (std::size_t i = 0; i < kCount; ++i) ASSERT_EQ(numbers[i + 1], i);
+
+  // The bad values fall into different slices.
+  values[kCount - 1] = "x";
+  values[3 * kMinValuesPerThread + 5] = "-1";
+  numbers.clear();
+  EXPECT_FALSE(AppendNumbers(values, &numbers, &bad_index, 4));
+  EXPECT_EQ(bad_index, 3 * kMinValuesPerThread + 5);
+  EXPECT_EQ(numbers.size(), bad_index);
+
+  // Serial by default, with the same result.
+  numbers.clear();
+  EXPECT_FALSE(AppendNumbers(values, &numbers, &bad_index));
+  EXPECT_EQ(bad_index, 3 * kMinValuesPerThread + 5);
+}
+
+TEST(ParallelFindFirst, CoversEveryIndexOnce) {
+  for (std::size_t n : {std::size_t{0}, std::size_t{1}, kMinValuesPerThread,
+                        5 * kMinValuesPerThread + 3}) {
+    std::vector<int> seen(n);
+    auto fn = [&seen](std::size_t begin, std::size_t end) {
+      for (auto i = begin; i < end; ++i) ++seen[i];
+      return end;
+    };
+    EXPECT_EQ(ParallelFindFirst(n, fn, 4), n);
+    EXPECT_EQ(std::count(seen.begin(), seen.end(), 1), n);
+  }
+
+  // The first bad index, even if a later slice finishes first.
+  constexpr std::size_t kCount = 4 * kMinValuesPerThread;
+  auto fn = [](std::size_t begin, std::size_t end) {
+    for (auto i = begin; i < end; ++i) {
+      if (i % kMinValuesPerThread == 9 && i > kMinValuesPerThread) return i;
+    }
+    return end;
+  };
+  EXPECT_EQ(ParallelFindFirst(kCount, fn, 4), kMinValuesPerThread + 9);
+}
+
+}  // namespace testing_internal
+}  // namespace internal
+}  // namespace argparse
@@ -5,13 +5,19 @@
 
 #pragma once
 
-#include <sstream>
+#include <istream>
 
 #include "absl/meta/type_traits.h"
 #include "absl/strings/ascii.h"
 #include "absl/strings/numbers.h"
 #include "absl/strings/string_view.h"
+#include "argparse/internal/argparse-net.h"
+#include "argparse/internal/argparse-parse-float.h"
+#include "argparse/internal/argparse-parse-int.h"
 #include "argparse/internal/argparse-std-parse.h"
+#include "argparse/internal/argparse-range-set.h"
+#include "argparse/internal/argparse-units.h"
+#include "argparse/internal/argparse-view-stream.h"
 
 // This file implements the default parser for various basic types.
 namespace argparse {
@@ -30,6 +36,12 @@ inline bool ArgparseParse(absl::string_view str, std::string* out) {
   return true;
 }
 
+// No copy, `out` points into the command line. See IsViewType.
+inline bool ArgparseParse(absl::string_view str, absl::string_view* out) {
+  *out = str;
+  return true;
+}
+
 inline bool ArgparseParse(absl::string_view str, char* out) {
   if (str.size() == 1 && absl::ascii_isprint(str.front())) {
     *out = str.front();
@@ -39,19 +51,56 @@ inline bool ArgparseParse(absl::string_view str, char* out) {
 }
 
 inline bool ArgparseParse(absl::string_view str, float* out) {
-  return absl::SimpleAtof(str, out);
+  return ParseFloat(str, out);
 }
 
 inline bool ArgparseParse(absl::string_view str, double* out) {
-  return absl::SimpleAtod(str, out);
+  return ParseFloat(str, out);
+}
+
+inline bool ArgparseParse(absl::string_view str, long double* out) {
+  return ParseFloat(str, out);
 }
 
+// Any width, with base prefixes, `_` separators and size suffixes. See
+// ParseIntegerMagnitude().
 template <typename int_type>
-absl::enable_if_t<std::is_integral<int_type>::value &&
-                      (sizeof(int_type) == 4 || sizeof(int_type) == 8),
-                  bool>  // Ensure `int_type` is a 4 or 8 bytes integer type.
-ArgparseParse(absl::string_view str, int_type* out) {
-  return absl::SimpleAtoi(str, out);
+absl::enable_if_t<IsParsedAsInteger<int_type>::value, bool> ArgparseParse(
+    absl::string_view str, int_type* out) {
+  return ParseInteger(str, out);
+}
+
+template <typename Rep, typename Period>
+bool ArgparseParse(absl::string_view str,
+                   std::chrono::duration<Rep, Period>* out) {
+  return units_internal::ParseDuration(str, out);
+}
+
+inline bool ArgparseParse(absl::string_view str, ByteSize* out) {
+  std::uint64_t bytes;
+  if (!units_internal::ParseByteSize(str, &bytes)) return false;
+  out->bytes = bytes;
+  return true;
+}
+
+inline bool ArgparseParse(absl::string_view str, RangeSet* out) {
+  return RangeSet::Parse(str, out);
+}
+
+#if ARGPARSE_INTERNAL_HAS_CPU_SET
+inline bool ArgparseParse(absl::string_view str, cpu_set_t* out) {
+  return range_set_internal::ParseCpuSet(str, out);
+}
+#endif  // ARGPARSE_INTERNAL_HAS_CPU_SET
+
+inline bool ArgparseParse(absl::string_view str, IpAddress* out) {
+  return IpAddress::Parse(str, out);
+}
+inline bool ArgparseParse(absl::string_view str, HostPort* out) {
+  return HostPort::Parse(str, out);
+}
+inline bool ArgparseParse(absl::string_view str, IpPrefix* out) {
+  return IpPrefix::Parse(str, out);
 }
 
 // Select a proper Parse() function for type `T`.
@@ -82,9 +131,9 @@ class ParseSelect {
         std::is_same<std::istream&, decltype(std::declval<std::istream&>() >>
                                              std::declval<T&>())>::value,
         bool> {
-      std::istringstream iss{std::string(str)};
-      iss >> *out;
-      return iss.good();
+      ScopedViewStream stream(str);
+      stream.stream() >> *out;
+      return stream.Succeeded();
     }
   };
 
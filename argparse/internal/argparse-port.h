@@ -5,9 +5,10 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <type_traits>
 #include <typeinfo>
-#include <memory>
 
 #include "absl/strings/string_view.h"
 
@@ -36,6 +37,37 @@ absl::string_view TypeName() {
 template <typename...>
 struct TypeList {};
 
+// A pointer-sized identifier of a type: the address of a per-type static.
+// Comparing two tags is a pointer compare, unlike std::type_index. Like
+// typeid, top-level cv-qualifiers are ignored.
+class TypeTag final {
+ public:
+  template <typename T>
+  static TypeTag Of() {
+    return TypeTag(&Anchor<typename std::remove_cv<T>::type>::kValue);
+  }
+
+  bool operator==(TypeTag that) const { return value_ == that.value_; }
+  bool operator!=(TypeTag that) const { return !(*this == that); }
+  // For ordered containers.
+  bool operator<(TypeTag that) const {
+    return std::less<const void*>()(value_, that.value_);
+  }
+
+ private:
+  template <typename T>
+  struct Anchor {
+    static const char kValue;
+  };
+
+  explicit TypeTag(const void* value) : value_(value) {}
+
+  const void* value_;
+};
+
+template <typename T>
+const char TypeTag::Anchor<T>::kValue = 0;
+
 // Support holding a piece of opaque data by subclass.
 class SupportUserData {
  public:
@@ -0,0 +1,150 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "argparse/internal/argparse-range-set.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/str_cat.h"
+
+namespace argparse {
+namespace internal {
+namespace {
+
+constexpr std::uint64_t kMax = std::numeric_limits<std::uint64_t>::max();
+
+// Take a decimal number from the front of `*p`, which is before `end`.
+bool ConsumeDecimal(const char** p, const char* end, std::uint64_t* out) {
+  const char* begin = *p;
+  std::uint64_t value = 0;
+  for (; *p != end && static_cast<unsigned char>(**p - '0') <= 9; ++*p) {
+    auto digit = static_cast<std::uint64_t>(**p - '0');
+    if (value > (kMax - digit) / 10) return false;
+    value = value * 10 + digit;
+  }
+  *out = value;
+  return *p != begin;
+}
+
+bool RangeLess(const RangeSet::Range& a, const RangeSet::Range& b) {
+  return a.first < b.first;
+}
+
+}  // namespace
+
+bool RangeSet::Contains(std::uint64_t value) const {
+  // The first range that starts after `value`; the one before may hold it.
+  auto iter = std::upper_bound(
+      ranges_.begin(), ranges_.end(), value,
+      [](std::uint64_t v, const Range& range) { return v < range.first; });
+  return iter != ranges_.begin() && value <= (iter - 1)->last;
+}
+
+std::uint64_t RangeSet::GetCount() const {
+  std::uint64_t count = 0;
+  for (const auto& range : ranges_) {
+    auto size = range.last - range.first;
+    // size + 1 more.
+    if (size >= kMax - count) return kMax;
+    count += size + 1;
+  }
+  return count;
+}
+
+bool RangeSet::Parse(absl::string_view str, RangeSet* out) {
+  str = absl::StripAsciiWhitespace(str);
+  if (str.empty()) return false;
+  RangeVector ranges;
+  const char* p = str.data();
+  const char* end = p + str.size();
+  // Whether the ranges so far are in order, so no sorting is needed.
+  bool sorted = true;
+  while (p != end) {
+    Range range;
+    if (!ConsumeDecimal(&p, end, &range.first)) return false;
+    range.last = range.first;
+    if (p != end && *p == '-') {
+      ++p;
+      if (!ConsumeDecimal(&p, end, &range.last)) return false;
+      if (range.last < range.first) return false;
+    }
+    if (p != end) {
+      // A ',' must be followed by another range.
+      if (*p != ',' || ++p == end) return false;
+    }
+    if (!ranges.empty() && ranges.back().first >= range.first) sorted = false;
+    ranges.push_back(range);
+  }
+  if (!sorted) std::sort(ranges.begin(), ranges.end(), &RangeLess);
+
+  // Reject overlaps and merge the adjacent ranges in place.
+  std::size_t size = 0;
+  for (const auto& range : ranges) {
+    if (size) {
+      auto& last = ranges[size - 1];
+      if (range.first <= last.last) return false;
+      if (range.first == last.last + 1) {
+        last.last = range.last;
+        continue;
+      }
+    }
+    ranges[size++] = range;
+  }
+  ranges.resize(size);
+  out->ranges_ = std::move(ranges);
+  return true;
+}
+
+std::string RangeSet::Format() const {
+  std::string out;
+  for (const auto& range : ranges_) {
+    if (!out.empty()) out.push_back(',');
+    absl::StrAppend(&out, range.first);
+    if (range.last != range.first) absl::StrAppend(&out, "-", range.last);
+  }
+  return out;
+}
+
+#if ARGPARSE_INTERNAL_HAS_CPU_SET
+namespace range_set_internal {
+
+bool ParseCpuSet(absl::string_view str, cpu_set_t* out) {
+  RangeSet cpus;
+  if (!RangeSet::Parse(str, &cpus)) return false;
+  if (!cpus.empty() && cpus.GetRanges().back().last >= CPU_SETSIZE)
+    return false;
+  CPU_ZERO(out);
+  for (const auto& range : cpus.GetRanges()) {
+    for (auto cpu = range.first; cpu <= range.last; ++cpu)
+      CPU_SET(static_cast<int>(cpu), out);
+  }
+  return true;
+}
+
+std::string FormatCpuSet(const cpu_set_t& set) {
+  std::string out;
+  int cpu = 0;
+  while (cpu < CPU_SETSIZE) {
+    if (!CPU_ISSET(cpu, &set)) {
+      ++cpu;
+      continue;
+    }
+    int first = cpu;
+    while (cpu + 1 < CPU_SETSIZE && CPU_ISSET(cpu + 1, &set)) ++cpu;
+    if (!out.empty()) out.push_back(',');
+    absl::StrAppend(&out, first);
+    if (cpu != first) absl::StrAppend(&out, "-", cpu);
+    ++cpu;
+  }
+  return out;
+}
+
+}  // namespace range_set_internal
+#endif  // ARGPARSE_INTERNAL_HAS_CPU_SET
+
+}  // namespace internal
+}  // namespace argparse
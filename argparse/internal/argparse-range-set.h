@@ -0,0 +1,85 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "absl/container/inlined_vector.h"
+#include "absl/strings/string_view.h"
+
+#if defined(__linux__)
+#include <sched.h>
+#define ARGPARSE_INTERNAL_HAS_CPU_SET 1
+#else
+#define ARGPARSE_INTERNAL_HAS_CPU_SET 0
+#endif
+
+// Sets of integers given as ranges: "0-63,128-191" or "1-1000,2000".
+namespace argparse {
+namespace internal {
+
+// A set of unsigned integers kept as sorted, disjoint intervals, so a large
+// range takes no more room than a small one. Up to 4 intervals are held
+// inline.
+class RangeSet {
+ public:
+  // [first, last], both included.
+  struct Range {
+    std::uint64_t first;
+    std::uint64_t last;
+  };
+  using RangeVector = absl::InlinedVector<Range, 4>;
+
+  RangeSet() = default;
+
+  // Sorted by `first`, with gaps between them.
+  const RangeVector& GetRanges() const { return ranges_; }
+  bool empty() const { return ranges_.empty(); }
+  bool Contains(std::uint64_t value) const;
+  // The number of values, or max() if it doesn't fit uint64_t.
+  std::uint64_t GetCount() const;
+
+  // Parse a list of `N` or `N-M` separated by ',', where N and M are decimal
+  // and N <= M, with ASCII whitespace around the list. The list may not be
+  // empty. The ranges may come in any order, but may not overlap. Adjacent
+  // ones are merged, e.g., "4-7,0-3" is "0-7".
+  // The input is scanned once, and up to 4 ranges take no allocation.
+  static bool Parse(absl::string_view str, RangeSet* out);
+
+  // The inverse of Parse(), e.g., "0-7,9".
+  std::string Format() const;
+
+ private:
+  RangeVector ranges_;
+};
+
+inline bool operator==(const RangeSet::Range& lhs,
+                       const RangeSet::Range& rhs) {
+  return lhs.first == rhs.first && lhs.last == rhs.last;
+}
+inline bool operator==(const RangeSet& lhs, const RangeSet& rhs) {
+  return lhs.GetRanges() == rhs.GetRanges();
+}
+inline bool operator!=(const RangeSet& lhs, const RangeSet& rhs) {
+  return !(lhs == rhs);
+}
+
+#if ARGPARSE_INTERNAL_HAS_CPU_SET
+namespace range_set_internal {
+
+// Parse a CPU list like RangeSet::Parse() into `out`, e.g., "0-3,8". Fail if
+// a CPU is not below CPU_SETSIZE.
+bool ParseCpuSet(absl::string_view str, cpu_set_t* out);
+
+// The CPUs in `set` as a list, e.g., "0-3,8".
+std::string FormatCpuSet(const cpu_set_t& set);
+
+}  // namespace range_set_internal
+#endif  // ARGPARSE_INTERNAL_HAS_CPU_SET
+
+}  // namespace internal
+}  // namespace argparse
@@ -0,0 +1,85 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "argparse/internal/argparse-range-set.h"
+
+#include <limits>
+
+#include "argparse/argparse-builder.h"
+#include "argparse/internal/argparse-parse-traits.h"
+#include "gtest/gtest.h"
+
+namespace argparse {
+namespace internal {
+namespace testing_internal {
+
+using Ranges = RangeSet::RangeVector;
+
+TEST(RangeSet, Parse) {
+  RangeSet set;
+  EXPECT_TRUE(Parse("0-63,128-191", &set));
+  EXPECT_EQ(set.GetRanges(), (Ranges{{0, 63}, {128, 191}}));
+  EXPECT_EQ(set.GetCount(), 128);
+  EXPECT_TRUE(Parse("1-1000,2000", &set));
+  EXPECT_EQ(set.GetRanges(), (Ranges{{1, 1000}, {2000, 2000}}));
+  EXPECT_TRUE(Parse(" 3-5\n", &set));
+  EXPECT_EQ(set.GetRanges(), (Ranges{{3, 5}}));
+
+  // Sorted and merged.
+  EXPECT_TRUE(Parse("9,4-7,0-3", &set));
+  EXPECT_EQ(set.GetRanges(), (Ranges{{0, 7}, {9, 9}}));
+
+  // A large range is still one interval.
+  EXPECT_TRUE(Parse("0-18446744073709551615", &set));
+  EXPECT_EQ(set.GetRanges().size(), 1);
+  EXPECT_EQ(set.GetCount(), std::numeric_limits<std::uint64_t>::max());
+}
+
+TEST(RangeSet, Malformed) {
+  RangeSet set;
+  ASSERT_TRUE(Parse("7", &set));
+  for (const char* input :
+       {"", " ", "5-3", "0-4,3-8", "1,1", "2-6,4", ",", "1,", ",1", "1-",
+        "-1", "1--2", "a", "1 ,2", "0x10", "18446744073709551616"}) {
+    EXPECT_FALSE(Parse(input, &set)) << input;
+  }
+  EXPECT_EQ(set.GetRanges(), (Ranges{{7, 7}}));
+}
+
+TEST(RangeSet, Contains) {
+  RangeSet set;
+  ASSERT_TRUE(Parse("2-4,10,20-30", &set));
+  for (std::uint64_t value : {2, 3, 4, 10, 20, 25, 30})
+    EXPECT_TRUE(set.Contains(value)) << value;
+  for (std::uint64_t value : {0, 1, 5, 9, 11, 19, 31})
+    EXPECT_FALSE(set.Contains(value)) << value;
+}
+
+TEST(RangeSet, HintAndFormat) {
+  RangeSet set;
+  ASSERT_TRUE(Parse("4-7,0-3,9", &set));
+  EXPECT_EQ(TypeHint<RangeSet>(), "ranges");
+  EXPECT_EQ(FormatValue(set), "0-7,9");
+}
+
+#if ARGPARSE_INTERNAL_HAS_CPU_SET
+TEST(CpuSet, Parse) {
+  cpu_set_t cpus;
+  EXPECT_TRUE(Parse("0-3,8", &cpus));
+  EXPECT_EQ(CPU_COUNT(&cpus), 5);
+  EXPECT_TRUE(CPU_ISSET(3, &cpus));
+  EXPECT_FALSE(CPU_ISSET(4, &cpus));
+  EXPECT_TRUE(CPU_ISSET(8, &cpus));
+  EXPECT_EQ(FormatValue(cpus), "0-3,8");
+  EXPECT_EQ(TypeHint<cpu_set_t>(), "ranges");
+
+  EXPECT_FALSE(Parse(std::to_string(CPU_SETSIZE), &cpus));
+  EXPECT_FALSE(Parse("3-1", &cpus));
+}
+#endif  // ARGPARSE_INTERNAL_HAS_CPU_SET
+
+}  // namespace testing_internal
+}  // namespace internal
+}  // namespace argparse
@@ -0,0 +1,67 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "argparse/internal/argparse-string-pool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+namespace argparse {
+namespace internal {
+
+constexpr std::size_t StringPool::kMinBlockSize;
+constexpr std::size_t StringPool::kMaxBlockSize;
+
+absl::string_view StringPool::Intern(absl::string_view str) {
+  auto iter = index_.find(str);
+  if (iter != index_.end()) return *iter;
+
+  // Keep a NUL after each string.
+  char* data = Allocate(str.size() + 1);
+  if (!str.empty()) std::memcpy(data, str.data(), str.size());
+  data[str.size()] = '\0';
+
+  absl::string_view result(data, str.size());
+  index_.insert(result);
+  return result;
+}
+
+bool StringPool::Owns(absl::string_view str) const {
+  std::less_equal<const char*> less_equal;
+  for (const auto& block : blocks_) {
+    const char* begin = block.data.get();
+    if (less_equal(begin, str.data()) &&
+        less_equal(str.data() + str.size(), begin + block.size))
+      return true;
+  }
+  return false;
+}
+
+void StringPool::AddMemoryUsage(MemoryUsage* usage) const {
+  usage->AddObject(*this);
+  usage->AddBuffer(blocks_);
+  for (const auto& block : blocks_) usage->AddAllocation(block.size);
+  usage->AddHashTable(index_);
+}
+
+char* StringPool::Allocate(std::size_t size) {
+  if (blocks_.empty() || blocks_.back().size - used_ < size) {
+    auto block_size =
+        blocks_.empty() ? kMinBlockSize
+                        : std::min(2 * blocks_.back().size, kMaxBlockSize);
+    // A large string gets a block of its own.
+    block_size = std::max(block_size, size);
+    blocks_.push_back({std::unique_ptr<char[]>(new char[block_size]),
+                       block_size});
+    used_ = 0;
+  }
+  char* result = blocks_.back().data.get() + used_;
+  used_ += size;
+  return result;
+}
+
+}  // namespace internal
+}  // namespace argparse
@@ -0,0 +1,104 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/meta/type_traits.h"
+#include "absl/strings/string_view.h"
+#include "argparse/internal/argparse-memory-usage.h"
+
+namespace argparse {
+namespace internal {
+
+// A deduplicating pool of strings. Strings are copied into a few large blocks,
+// so interning many small strings costs few allocations. Views returned by
+// Intern() are NUL-terminated (C backends can use their data()) and stay valid
+// as long as the pool is alive.
+class StringPool final {
+ public:
+  StringPool() = default;
+  StringPool(const StringPool&) = delete;
+  StringPool& operator=(const StringPool&) = delete;
+
+  // Return a view of the pool's copy of `str`. Equal strings are stored once.
+  absl::string_view Intern(absl::string_view str);
+
+  // Whether `str` points into the storage of this pool.
+  bool Owns(absl::string_view str) const;
+
+  // Return the number of distinct strings in the pool.
+  std::size_t GetStringCount() const { return index_.size(); }
+
+  // Make room for `count` more distinct strings.
+  void Reserve(std::size_t count) { index_.reserve(index_.size() + count); }
+
+  // Count the pool itself, its blocks and its index.
+  void AddMemoryUsage(MemoryUsage* usage) const;
+
+ private:
+  struct Block {
+    std::unique_ptr<char[]> data;
+    std::size_t size;
+  };
+
+  // Return `size` bytes of storage from the current block.
+  char* Allocate(std::size_t size);
+
+  // Blocks grow from kMinBlockSize to kMaxBlockSize, so that a pool holding a
+  // few strings stays small.
+  static constexpr std::size_t kMinBlockSize = 64;
+  static constexpr std::size_t kMaxBlockSize = 4096;
+
+  std::vector<Block> blocks_;
+  std::size_t used_ = 0;  // Bytes used in blocks_.back().
+  absl::flat_hash_set<absl::string_view> index_;
+};
+
+// A string handed to the builder, which remembers whether it is a string
+// literal. A literal has static storage duration, so we keep a view of it.
+// Any other string is copied into a StringPool.
+// Note: a const char array is taken as a literal, so make a local buffer
+// non-const (or pass a std::string) to have it copied.
+class SpecString final {
+ public:
+  template <std::size_t N>
+  SpecString(const char (&literal)[N]) : str_(literal), is_literal_(true) {}
+
+  // A mutable buffer may be reused or go out of scope, so it is copied. The
+  // string ends at the first NUL, or at the end of the buffer.
+  template <std::size_t N>
+  SpecString(char (&buffer)[N])
+      : str_(buffer, std::find(buffer, buffer + N, '\0') - buffer),
+        is_literal_(false) {}
+
+  template <typename S, absl::enable_if_t<
+                            !std::is_array<S>::value &&
+                            std::is_convertible<const S&,
+                                                absl::string_view>::value>* =
+                            nullptr>
+  SpecString(const S& str) : str_(str), is_literal_(false) {}
+
+  absl::string_view str() const { return str_; }
+  bool is_literal() const { return is_literal_; }
+
+  // Return a view that outlives this object: the literal itself, or the copy
+  // held by `pool`.
+  absl::string_view Resolve(StringPool* pool) const {
+    return is_literal() ? str() : pool->Intern(str());
+  }
+
+ private:
+  absl::string_view str_;
+  bool is_literal_;
+};
+
+}  // namespace internal
+}  // namespace argparse
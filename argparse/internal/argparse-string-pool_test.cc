@@ -0,0 +1,116 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "argparse/internal/argparse-string-pool.h"
+
+#include "argparse/internal/argparse-argument-builder.h"
+#include "argparse/internal/argparse-argument-holder.h"
+#include "gtest/gtest.h"
+
+namespace argparse {
+namespace internal {
+namespace testing_internal {
+
+TEST(StringPool, InternDeduplicates) {
+  StringPool pool;
+  std::string a = "help", b = "help";
+  auto view_a = pool.Intern(a);
+  auto view_b = pool.Intern(b);
+  EXPECT_EQ(view_a, "help");
+  EXPECT_EQ(view_a.data(), view_b.data());
+  EXPECT_EQ(pool.GetStringCount(), 1);
+}
+
+TEST(StringPool, InternedStringsAreNulTerminated) {
+  StringPool pool;
+  auto view = pool.Intern(absl::string_view("abcdef", 3));
+  EXPECT_EQ(view.data()[view.size()], '\0');
+  EXPECT_STREQ(view.data(), "abc");
+}
+
+TEST(StringPool, ViewsAreStable) {
+  StringPool pool;
+  auto first = pool.Intern("first");
+  for (int i = 0; i < 10000; ++i) pool.Intern(std::to_string(i));
+  EXPECT_EQ(first, "first");
+  EXPECT_EQ(pool.GetStringCount(), 10001);
+}
+
+TEST(StringPool, Owns) {
+  StringPool pool;
+  std::string str = "name";
+  EXPECT_TRUE(pool.Owns(pool.Intern(str)));
+  EXPECT_FALSE(pool.Owns(str));
+  EXPECT_FALSE(pool.Owns("name"));
+}
+
+TEST(SpecString, LiteralIsKeptByView) {
+  static constexpr char kLiteral[] = "literal";
+  SpecString str(kLiteral);
+  EXPECT_TRUE(str.is_literal());
+  EXPECT_EQ(str.str().data(), kLiteral);
+
+  StringPool pool;
+  EXPECT_EQ(str.Resolve(&pool).data(), kLiteral);
+  EXPECT_EQ(pool.GetStringCount(), 0);
+}
+
+TEST(SpecString, OtherStringIsCopied) {
+  std::string dynamic = "dynamic";
+  SpecString str(dynamic);
+  EXPECT_FALSE(str.is_literal());
+
+  StringPool pool;
+  auto view = str.Resolve(&pool);
+  EXPECT_EQ(view, dynamic);
+  EXPECT_TRUE(pool.Owns(view));
+}
+
+TEST(SpecString, MutableBufferIsCopied) {
+  char buffer[16] = "--name";
+  SpecString str(buffer);
+  EXPECT_FALSE(str.is_literal());
+
+  StringPool pool;
+  auto view = str.Resolve(&pool);
+  EXPECT_TRUE(pool.Owns(view));
+  // The buffer can be reused.
+  buffer[2] = 'x';
+  EXPECT_EQ(view, "--name");
+}
+
+TEST(StringPool, ArgumentStringsAreInternedOnRegistration) {
+  StringPool pool;
+  ArgumentHolder holder(&pool);
+  int a, b;
+  std::string help = "shared help";
+
+  for (int i = 0; i < 2; ++i) {
+    ArgumentBuilder builder;
+    std::string name = "--flag" + std::to_string(i);
+    builder.SetSingleName(name);
+    builder.SetDest(DestInfo::CreateFromPtr(i ? &a : &b));
+    builder.SetHelp(help);
+    builder.SetMetaVar("N");
+    holder.AddArgument(builder.Build());
+  }
+
+  auto* group = holder.GetDefaultGroup(ArgumentGroup::kOptionalGroupIndex);
+  ASSERT_EQ(group->GetArgumentCount(), 2);
+  auto* arg_0 = group->GetArgument(0);
+  auto* arg_1 = group->GetArgument(1);
+
+  EXPECT_EQ(arg_0->GetNames()->GetName(0), "--flag0");
+  EXPECT_TRUE(pool.Owns(arg_0->GetNames()->GetName(0)));
+  // The same help is stored once.
+  EXPECT_EQ(arg_0->GetHelpDoc().data(), arg_1->GetHelpDoc().data());
+  // Literals are not copied.
+  EXPECT_FALSE(pool.Owns(arg_0->GetMetaVar()));
+  EXPECT_EQ(pool.GetStringCount(), 3);
+}
+
+}  // namespace testing_internal
+}  // namespace internal
+}  // namespace argparse
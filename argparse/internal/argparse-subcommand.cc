@@ -8,5 +8,16 @@ SubCommand::SubCommand() {
   names_.resize(1);
 }
 
+void SubCommand::AddMemoryUsage(MemoryReport* report) const {
+  MemoryReport sub;
+  holder_.AddMemoryUsage(&sub);
+  sub.groups.AddObject(*this);
+  sub.strings.AddBuffer(names_);
+  for (const auto& name : names_) sub.strings.AddBuffer(name);
+  sub.strings.AddBuffer(help_);
+  report->AddKinds(sub);
+  report->per_subcommand.push_back({std::string(GetName()), sub.GetTotal()});
+}
+
 }  // namespace internal
 }  // namespace argparse
@@ -42,6 +42,10 @@ class SubCommand final {
     absl::string_view GetHelp() const { return help_; }
     ArgumentHolder* GetHolder() { return &holder_; }
 
+    // Add the memory of this subcommand and its arguments to `report`, with an
+    // entry in `per_subcommand`.
+    void AddMemoryUsage(MemoryReport* report) const;
+
     static std::unique_ptr<SubCommand> Create(std::string name) {
       auto cmd = Create();
       cmd->SetName(std::move(name));
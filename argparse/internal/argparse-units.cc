@@ -0,0 +1,231 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "argparse/internal/argparse-units.h"
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/str_cat.h"
+
+namespace argparse {
+namespace internal {
+namespace units_internal {
+namespace {
+
+constexpr std::uint64_t kMax = std::numeric_limits<std::uint64_t>::max();
+
+// Digits of a fraction beyond these are dropped. 10^9 keeps the products
+// below in 64 bits.
+constexpr int kMaxFractionDigits = 9;
+
+// A decimal number with an optional fraction, like "1", "1.5" or ".5".
+struct Number {
+  std::uint64_t whole = 0;
+  std::uint64_t fraction = 0;
+  // fraction / scale is the value of the fraction.
+  std::uint64_t scale = 1;
+};
+
+// Take a Number from the front of `str`. Fail if there is no digit, or if the
+// whole part overflows.
+bool ConsumeNumber(absl::string_view* str, Number* number) {
+  const char* p = str->data();
+  const char* end = p + str->size();
+  bool any_digit = false;
+  for (; p != end && absl::ascii_isdigit(*p); ++p) {
+    auto digit = static_cast<std::uint64_t>(*p - '0');
+    if (number->whole > (kMax - digit) / 10) return false;
+    number->whole = number->whole * 10 + digit;
+    any_digit = true;
+  }
+  if (p != end && *p == '.') {
+    int digits = 0;
+    for (++p; p != end && absl::ascii_isdigit(*p); ++p) {
+      any_digit = true;
+      if (digits == kMaxFractionDigits) continue;
+      number->fraction = number->fraction * 10 + (*p - '0');
+      number->scale *= 10;
+      ++digits;
+    }
+  }
+  str->remove_prefix(p - str->data());
+  return any_digit;
+}
+
+// Take the unit, i.e., the chars up to the next number.
+absl::string_view ConsumeUnit(absl::string_view* str) {
+  std::size_t size = 0;
+  while (size < str->size() && !absl::ascii_isdigit((*str)[size]) &&
+         (*str)[size] != '.')
+    ++size;
+  auto unit = str->substr(0, size);
+  str->remove_prefix(size);
+  return unit;
+}
+
+// Set `*out` to number * factor. `*exact` tells whether no fraction of the
+// result was dropped. Fail on overflow.
+bool Multiply(const Number& number, std::uint64_t factor, std::uint64_t* out,
+              bool* exact) {
+  if (factor && number.whole > kMax / factor) return false;
+  std::uint64_t result = number.whole * factor;
+  // fraction * factor / scale, without overflow: both fraction and the
+  // remainder are below scale, which is at most 10^9.
+  std::uint64_t quotient = factor / number.scale;
+  std::uint64_t remainder = factor % number.scale;
+  std::uint64_t part = number.fraction * quotient +
+                       number.fraction * remainder / number.scale;
+  *exact = number.fraction * remainder % number.scale == 0;
+  if (result > kMax - part) return false;
+  *out = result + part;
+  return true;
+}
+
+struct Unit {
+  absl::string_view name;
+  std::uint64_t factor;
+};
+
+bool LookupUnit(absl::string_view name, const Unit* units, std::size_t count,
+                std::uint64_t* factor) {
+  for (std::size_t i = 0; i < count; ++i) {
+    if (units[i].name == name) {
+      *factor = units[i].factor;
+      return true;
+    }
+  }
+  return false;
+}
+
+constexpr std::uint64_t kSecond = 1000000000;
+
+constexpr Unit kDurationUnits[] = {
+    {"ns", 1},
+    {"us", 1000},
+    // U+00B5 MICRO SIGN and U+03BC GREEK SMALL LETTER MU.
+    {"\xC2\xB5s", 1000},
+    {"\xCE\xBCs", 1000},
+    {"ms", 1000000},
+    {"s", kSecond},
+    {"m", 60 * kSecond},
+    {"h", 3600 * kSecond},
+};
+
+constexpr Unit kByteUnits[] = {
+    {"", 1},
+    {"B", 1},
+    {"k", 1000ULL},
+    {"kB", 1000ULL},
+    {"M", 1000000ULL},
+    {"MB", 1000000ULL},
+    {"G", 1000000000ULL},
+    {"GB", 1000000000ULL},
+    {"T", 1000000000000ULL},
+    {"TB", 1000000000000ULL},
+    {"Ki", 1ULL << 10},
+    {"KiB", 1ULL << 10},
+    {"Mi", 1ULL << 20},
+    {"MiB", 1ULL << 20},
+    {"Gi", 1ULL << 30},
+    {"GiB", 1ULL << 30},
+    {"Ti", 1ULL << 40},
+    {"TiB", 1ULL << 40},
+};
+
+template <std::size_t N>
+std::string FormatInLargestUnit(std::uint64_t value, const Unit (&units)[N],
+                                absl::string_view zero) {
+  if (value == 0) return std::string(zero);
+  const Unit* best = nullptr;
+  for (const auto& unit : units) {
+    if (value % unit.factor == 0 && (!best || unit.factor > best->factor))
+      best = &unit;
+  }
+  return absl::StrCat(value / best->factor, best->name);
+}
+
+}  // namespace
+
+bool ParseNanoseconds(absl::string_view str, std::int64_t* nanos) {
+  str = absl::StripAsciiWhitespace(str);
+  bool negative = false;
+  if (!str.empty() && (str.front() == '+' || str.front() == '-')) {
+    negative = str.front() == '-';
+    str.remove_prefix(1);
+  }
+  if (str == "0") {
+    *nanos = 0;
+    return true;
+  }
+  if (str.empty()) return false;
+
+  // The magnitude of int64_t's min().
+  constexpr auto kLimit =
+      static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()) + 1;
+  std::uint64_t total = 0;
+  while (!str.empty()) {
+    Number number;
+    if (!ConsumeNumber(&str, &number)) return false;
+    std::uint64_t factor, value;
+    bool exact;
+    if (!LookupUnit(ConsumeUnit(&str), kDurationUnits,
+                    sizeof(kDurationUnits) / sizeof(kDurationUnits[0]),
+                    &factor) ||
+        !Multiply(number, factor, &value, &exact) || !exact)
+      return false;
+    if (value > kLimit - total) return false;
+    total += value;
+  }
+  if (!negative && total == kLimit) return false;
+  *nanos = negative ? static_cast<std::int64_t>(0 - total)
+                    : static_cast<std::int64_t>(total);
+  return true;
+}
+
+bool ParseByteSize(absl::string_view str, std::uint64_t* bytes) {
+  str = absl::StripAsciiWhitespace(str);
+  if (!str.empty() && str.front() == '+') str.remove_prefix(1);
+  Number number;
+  if (!ConsumeNumber(&str, &number)) return false;
+  std::uint64_t factor, value;
+  bool exact;
+  if (!LookupUnit(str, kByteUnits, sizeof(kByteUnits) / sizeof(kByteUnits[0]),
+                  &factor) ||
+      !Multiply(number, factor, &value, &exact) || !exact)
+    return false;
+  *bytes = value;
+  return true;
+}
+
+std::string FormatNanoseconds(std::int64_t nanos) {
+  // Only the ASCII units.
+  static constexpr Unit kUnits[] = {
+      {"ns", 1},      {"us", 1000},        {"ms", 1000000},
+      {"s", kSecond}, {"m", 60 * kSecond}, {"h", 3600 * kSecond},
+  };
+  auto magnitude = nanos < 0 ? 0 - static_cast<std::uint64_t>(nanos)
+                             : static_cast<std::uint64_t>(nanos);
+  return absl::StrCat(nanos < 0 ? "-" : "",
+                      FormatInLargestUnit(magnitude, kUnits, "0s"));
+}
+
+std::string FormatByteSize(std::uint64_t bytes) {
+  // Without the short spellings.
+  static constexpr Unit kUnits[] = {
+      {"B", 1},
+      {"kB", 1000ULL},
+      {"MB", 1000000ULL},
+      {"GB", 1000000000ULL},
+      {"TB", 1000000000000ULL},
+      {"KiB", 1ULL << 10},
+      {"MiB", 1ULL << 20},
+      {"GiB", 1ULL << 30},
+      {"TiB", 1ULL << 40},
+  };
+  return FormatInLargestUnit(bytes, kUnits, "0B");
+}
+
+}  // namespace units_internal
+}  // namespace internal
+}  // namespace argparse
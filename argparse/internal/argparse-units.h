@@ -0,0 +1,104 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <ratio>
+#include <string>
+#include <type_traits>
+
+#include "absl/strings/string_view.h"
+
+// Value types with units: durations and byte sizes.
+namespace argparse {
+namespace internal {
+
+// A number of bytes, parsed from a size like "4GiB" or "512k".
+struct ByteSize {
+  std::uint64_t bytes = 0;
+
+  ByteSize() = default;
+  explicit constexpr ByteSize(std::uint64_t b) : bytes(b) {}
+};
+
+inline bool operator==(ByteSize lhs, ByteSize rhs) {
+  return lhs.bytes == rhs.bytes;
+}
+inline bool operator!=(ByteSize lhs, ByteSize rhs) { return !(lhs == rhs); }
+
+namespace units_internal {
+
+// Parse a duration into nanoseconds. It is a sequence of decimal numbers,
+// each with an optional fraction and a unit, and an optional sign in front,
+// e.g., "250ms", "1h30m", "-1.5s". The units are ns, us (or µs), ms, s, m and
+// h. A bare "0" is also taken. The digits of a fraction beyond the 9th are
+// ignored. Fail on a syntax error, if a part is not a whole number of
+// nanoseconds, like "1.5ns", or if the sum doesn't fit int64_t.
+bool ParseNanoseconds(absl::string_view str, std::int64_t* nanos);
+
+// Parse a byte size: a decimal number with an optional fraction and unit.
+// The units are B; k, M, G, T (or kB, MB, GB, TB) for powers of 1000; and
+// Ki, Mi, Gi, Ti (or KiB, MiB, GiB, TiB) for powers of 1024. The number of
+// bytes must be whole, so "1.5k" is taken but "1.5" is not.
+bool ParseByteSize(absl::string_view str, std::uint64_t* bytes);
+
+// "250ms", "90m", "0s": the number in the largest unit that divides it.
+std::string FormatNanoseconds(std::int64_t nanos);
+// "4GiB", "1500B": likewise.
+std::string FormatByteSize(std::uint64_t bytes);
+
+template <typename T>
+struct IsDuration : std::false_type {};
+template <typename Rep, typename Period>
+struct IsDuration<std::chrono::duration<Rep, Period>> : std::true_type {};
+
+template <typename Rep, typename Period>
+bool NanosecondsToDuration(std::true_type, std::int64_t nanos,
+                           std::chrono::duration<Rep, Period>* out) {
+  using Duration = std::chrono::duration<Rep, Period>;
+  *out = std::chrono::duration_cast<Duration>(std::chrono::nanoseconds(nanos));
+  return true;
+}
+
+template <typename Rep, typename Period>
+bool NanosecondsToDuration(std::false_type, std::int64_t nanos,
+                           std::chrono::duration<Rep, Period>* out) {
+  // The ratio of a unit of the duration to a nanosecond.
+  using Ratio = std::ratio_divide<Period, std::nano>;
+  static_assert(Ratio::den == 1, "Durations finer than 1ns are not supported");
+  if (nanos % Ratio::num != 0) return false;
+  auto count = nanos / Ratio::num;
+  if (count < 0 && !std::is_signed<Rep>::value) return false;
+  auto rep = static_cast<Rep>(count);
+  if (static_cast<std::int64_t>(rep) != count) return false;
+  *out = std::chrono::duration<Rep, Period>(rep);
+  return true;
+}
+
+// Integer durations must hold the value exactly, so "1500ms" is not a
+// std::chrono::seconds. Floating-point ones take the nearest value.
+template <typename Rep, typename Period>
+bool ParseDuration(absl::string_view str,
+                   std::chrono::duration<Rep, Period>* out) {
+  std::int64_t nanos;
+  if (!ParseNanoseconds(str, &nanos)) return false;
+  return NanosecondsToDuration(std::is_floating_point<Rep>{}, nanos, out);
+}
+
+template <typename Rep, typename Period>
+std::string FormatDuration(std::chrono::duration<Rep, Period> value) {
+  return FormatNanoseconds(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(value).count());
+}
+
+}  // namespace units_internal
+
+using units_internal::IsDuration;
+
+}  // namespace internal
+}  // namespace argparse
@@ -0,0 +1,104 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "argparse/internal/argparse-units.h"
+
+#include <chrono>
+#include <cstdint>
+
+#include "argparse/argparse-builder.h"
+#include "argparse/internal/argparse-parse-traits.h"
+#include "gtest/gtest.h"
+
+namespace argparse {
+namespace internal {
+namespace testing_internal {
+
+using std::chrono::hours;
+using std::chrono::milliseconds;
+using std::chrono::minutes;
+using std::chrono::nanoseconds;
+using std::chrono::seconds;
+
+TEST(ParseDuration, Components) {
+  nanoseconds value;
+  EXPECT_TRUE(Parse("250ms", &value));
+  EXPECT_EQ(value, milliseconds(250));
+  EXPECT_TRUE(Parse("1h30m", &value));
+  EXPECT_EQ(value, minutes(90));
+  EXPECT_TRUE(Parse("-1.5s", &value));
+  EXPECT_EQ(value, milliseconds(-1500));
+  EXPECT_TRUE(Parse("2us3ns", &value));
+  EXPECT_EQ(value, nanoseconds(2003));
+  EXPECT_TRUE(Parse("1\xC2\xB5s", &value));
+  EXPECT_EQ(value, nanoseconds(1000));
+  EXPECT_TRUE(Parse("0", &value));
+  EXPECT_EQ(value, nanoseconds(0));
+  EXPECT_TRUE(Parse(".5h", &value));
+  EXPECT_EQ(value, minutes(30));
+}
+
+TEST(ParseDuration, Malformed) {
+  nanoseconds value(7);
+  for (const char* input :
+       {"", "1", "s", "1x", "1.s5", "1h-2m", "1 h", "9999999999h", "--1s",
+        "1.5ns", "1us0.5ns", "0.0001us"}) {
+    EXPECT_FALSE(Parse(input, &value)) << input;
+  }
+  EXPECT_EQ(value, nanoseconds(7));
+}
+
+TEST(ParseDuration, IntegerDurationsAreExact) {
+  seconds secs;
+  EXPECT_TRUE(Parse("2m", &secs));
+  EXPECT_EQ(secs, seconds(120));
+  EXPECT_FALSE(Parse("1500ms", &secs));
+
+  std::chrono::duration<std::int8_t> tiny;
+  EXPECT_TRUE(Parse("2m", &tiny));
+  EXPECT_FALSE(Parse("3m", &tiny));
+
+  std::chrono::duration<double> real;
+  EXPECT_TRUE(Parse("1500ms", &real));
+  EXPECT_DOUBLE_EQ(real.count(), 1.5);
+}
+
+TEST(ParseByteSize, Units) {
+  ByteSize size;
+  EXPECT_TRUE(Parse("4GiB", &size));
+  EXPECT_EQ(size.bytes, 4ULL << 30);
+  EXPECT_TRUE(Parse("512k", &size));
+  EXPECT_EQ(size.bytes, 512000);
+  EXPECT_TRUE(Parse("1.5KiB", &size));
+  EXPECT_EQ(size.bytes, 1536);
+  EXPECT_TRUE(Parse("100", &size));
+  EXPECT_EQ(size.bytes, 100);
+  EXPECT_TRUE(Parse("2TB", &size));
+  EXPECT_EQ(size.bytes, 2000000000000ULL);
+}
+
+TEST(ParseByteSize, Malformed) {
+  ByteSize size(7);
+  for (const char* input :
+       {"", "1.5", "1.0001k", "4K", "4gib", "-1", "1 GiB", "GiB",
+        "20000000TiB"}) {
+    EXPECT_FALSE(Parse(input, &size)) << input;
+  }
+  EXPECT_EQ(size.bytes, 7);
+}
+
+TEST(Units, HintAndFormat) {
+  EXPECT_EQ(TypeHint<milliseconds>(), "duration");
+  EXPECT_EQ(TypeHint<ByteSize>(), "bytes");
+  EXPECT_EQ(FormatValue(minutes(90)), "90m");
+  EXPECT_EQ(FormatValue(milliseconds(-250)), "-250ms");
+  EXPECT_EQ(FormatValue(seconds(0)), "0s");
+  EXPECT_EQ(FormatValue(ByteSize(4ULL << 30)), "4GiB");
+  EXPECT_EQ(FormatValue(ByteSize(1500)), "1500B");
+}
+
+}  // namespace testing_internal
+}  // namespace internal
+}  // namespace argparse
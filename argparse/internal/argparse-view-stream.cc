@@ -0,0 +1,67 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "argparse/internal/argparse-view-stream.h"
+
+#include <locale>
+
+namespace argparse {
+namespace internal {
+
+struct ScopedViewStream::Slot {
+  Slot() : stream(&buf) { stream.imbue(std::locale::classic()); }
+
+  ViewStreamBuf buf;
+  std::istream stream;
+  bool in_use = false;
+};
+
+ScopedViewStream::Slot* ScopedViewStream::GetThreadSlot() {
+  static thread_local Slot slot;
+  return &slot;
+}
+
+ScopedViewStream::ScopedViewStream(absl::string_view in) {
+  slot_ = GetThreadSlot();
+  owns_slot_ = slot_->in_use;
+  if (owns_slot_) slot_ = new Slot();
+  slot_->in_use = true;
+  slot_->buf.Reset(in);
+  stream_ = &slot_->stream;
+}
+
+ScopedViewStream::~ScopedViewStream() {
+  slot_->buf.Reset(absl::string_view());
+  if (owns_slot_) {
+    delete slot_;
+    return;
+  }
+  // Undo whatever operator>> did to the stream, so the next parse on this
+  // thread starts from a fresh one.
+  auto& stream = slot_->stream;
+  stream.exceptions(std::ios_base::goodbit);
+  stream.clear();
+  stream.flags(std::ios_base::skipws | std::ios_base::dec);
+  stream.width(0);
+  stream.precision(6);
+  stream.fill(' ');
+  stream.tie(nullptr);
+  if (stream.getloc() != std::locale::classic())
+    stream.imbue(std::locale::classic());
+  slot_->in_use = false;
+}
+
+bool ScopedViewStream::Succeeded() {
+  // The check below must not throw.
+  stream_->exceptions(std::ios_base::goodbit);
+  if (stream_->fail()) return false;
+  // Reaching EOF during the extraction is fine.
+  if (stream_->eof()) return true;
+  *stream_ >> std::ws;
+  return stream_->eof();
+}
+
+}  // namespace internal
+}  // namespace argparse
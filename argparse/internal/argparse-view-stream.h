@@ -0,0 +1,58 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <istream>
+#include <streambuf>
+
+#include "absl/strings/string_view.h"
+
+namespace argparse {
+namespace internal {
+
+// A read-only streambuf over the chars of a string_view, without a copy.
+class ViewStreamBuf final : public std::streambuf {
+ public:
+  void Reset(absl::string_view in) {
+    // The get area is never written to.
+    auto* begin = const_cast<char*>(in.data());
+    setg(begin, begin, begin + in.size());
+  }
+};
+
+// An istream over `in` for parsing by operator>>. The stream and its buffer
+// belong to the thread and are reused, so nothing is allocated and the
+// locale, which is always the classic one, is only imbued once. The state,
+// flags, exception mask and locale an operator>> sets are undone when the
+// scope ends. A nested use (an operator>> that parses again) gets a stream of
+// its own.
+class ScopedViewStream final {
+ public:
+  explicit ScopedViewStream(absl::string_view in);
+  ~ScopedViewStream();
+
+  ScopedViewStream(const ScopedViewStream&) = delete;
+  ScopedViewStream& operator=(const ScopedViewStream&) = delete;
+
+  std::istream& stream() { return *stream_; }
+
+  // Whether the extraction succeeded and took the whole input (trailing
+  // whitespace aside). Unlike good(), it holds if the value ends at EOF.
+  bool Succeeded();
+
+ private:
+  struct Slot;
+  // The slot of this thread.
+  static Slot* GetThreadSlot();
+
+  Slot* slot_;
+  // A nested use owns its slot.
+  bool owns_slot_;
+  std::istream* stream_;
+};
+
+}  // namespace internal
+}  // namespace argparse
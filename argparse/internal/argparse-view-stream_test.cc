@@ -0,0 +1,102 @@
+// Copyright (c) 2020 Feng Cong
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "argparse/internal/argparse-view-stream.h"
+
+#include <istream>
+#include <locale>
+#include <string>
+
+#include "argparse/internal/argparse-parse-traits.h"
+#include "gtest/gtest.h"
+
+namespace argparse {
+namespace internal {
+namespace testing_internal {
+
+// Only parsed by operator>>.
+struct UserId {
+  int shard = 0;
+  int local = 0;
+};
+
+std::istream& operator>>(std::istream& is, UserId& id) {
+  char colon = '\0';
+  is >> id.shard >> colon >> id.local;
+  if (colon != ':') is.setstate(std::ios_base::failbit);
+  return is;
+}
+
+// Parses a UserId from within operator>>.
+struct Nested {
+  UserId id;
+};
+
+std::istream& operator>>(std::istream& is, Nested& nested) {
+  std::string token;
+  is >> token;
+  if (!Parse(token, &nested.id)) is.setstate(std::ios_base::failbit);
+  return is;
+}
+
+TEST(ViewStream, ValueMayEndAtEof) {
+  UserId id;
+  EXPECT_TRUE(Parse("12:34", &id));
+  EXPECT_EQ(id.shard, 12);
+  EXPECT_EQ(id.local, 34);
+  EXPECT_TRUE(Parse(" 1:2 ", &id));
+}
+
+TEST(ViewStream, WholeInputMustBeTaken) {
+  UserId id;
+  EXPECT_FALSE(Parse("1:2x", &id));
+  EXPECT_FALSE(Parse("1-2", &id));
+  EXPECT_FALSE(Parse("", &id));
+}
+
+TEST(ViewStream, StateDoesNotLeakBetweenCalls) {
+  {
+    ScopedViewStream stream("ff");
+    int value;
+    stream.stream() >> std::hex >> value;
+    EXPECT_TRUE(stream.Succeeded());
+    EXPECT_EQ(value, 255);
+  }
+  UserId id;
+  EXPECT_TRUE(Parse("10:11", &id));
+  EXPECT_EQ(id.shard, 10);
+}
+
+TEST(ViewStream, SettingsAreRestored) {
+  {
+    ScopedViewStream stream("1.5");
+    auto& is = stream.stream();
+    is.exceptions(std::ios_base::failbit);
+    is.precision(2);
+    is.setf(std::ios_base::hex, std::ios_base::basefield);
+    is.imbue(std::locale(std::locale::classic(), new std::numpunct<char>()));
+  }
+  ScopedViewStream stream("");
+  auto& is = stream.stream();
+  EXPECT_EQ(is.exceptions(), std::ios_base::goodbit);
+  EXPECT_EQ(is.precision(), 6);
+  EXPECT_EQ(is.flags(), std::ios_base::skipws | std::ios_base::dec);
+  EXPECT_TRUE(is.getloc() == std::locale::classic());
+  // A failed parse doesn't throw.
+  int value;
+  is >> value;
+  EXPECT_FALSE(stream.Succeeded());
+}
+
+TEST(ViewStream, NestedUse) {
+  Nested nested;
+  EXPECT_TRUE(Parse("3:4", &nested));
+  EXPECT_EQ(nested.id.shard, 3);
+  EXPECT_EQ(nested.id.local, 4);
+}
+
+}  // namespace testing_internal
+}  // namespace internal
+}  // namespace argparse